@@ -11,16 +11,23 @@
 // 座標型が整数ならば整数演算で処理し、交点を有理表現で返す。
 // 標準の 64 bit 以下の整数座標では、既定で 128 bit 整数型を内部計算に用いる。
 // 計算途中に必要な値が内部計算の型に収まることを仮定する。
+// 64 bit 座標で交点の分子が Int128 に収まらない場合は、Calc に Int256 などを指定する。
+// Calc を指定しない場合は、まず 64 bit 整数でオーバーフローを検出しながら計算し、
+// オーバーフローした場合にのみ 128 bit 整数型で計算し直す。
 // 計算量 O(log N)。
 
 #include <cassert>
 #include <cmath>
 #include <complex>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "../internal/checked-arithmetic.hpp"
+#include "../internal/fixed-width-int.hpp"
 #include "../internal/int128.hpp"
 
 namespace line_convex_polygon_intersection_internal {
@@ -321,6 +328,24 @@ template <class Real> Real number_as_real(NicheLibrary::Int128 value) {
     }
     return number_as_real<Real>(bits);
 }
+
+template <class Real, std::size_t Words>
+Real number_as_real(const NicheLibrary::UIntN<Words> &value) {
+    Real result = 0;
+    for (std::size_t i = Words; i-- > 0;) {
+        result = std::ldexp(result, 64) + static_cast<Real>(value.word(i));
+    }
+    return result;
+}
+
+template <class Real, std::size_t Words>
+Real number_as_real(const NicheLibrary::IntN<Words> &value) {
+    const auto bits = NicheLibrary::UIntN<Words>::from_words(value.words());
+    if (value.is_negative()) {
+        return -number_as_real<Real>(-bits);
+    }
+    return number_as_real<Real>(bits);
+}
 } // namespace line_convex_polygon_intersection_internal
 
 template <class T> struct LineConvexHullIntersectionPoint {
@@ -664,6 +689,24 @@ line_strict_convex_polygon_intersection(const std::vector<Point> &polygon,
 }
 } // namespace line_convex_polygon_intersection_internal
 
+namespace line_convex_polygon_intersection_internal {
+template <class Point, class Calc>
+std::vector<result_value_t<Point, Calc>>
+line_convex_hull_intersection_with(const std::vector<Point> &hull,
+                                   const Point &line_a, const Point &line_b) {
+    const auto line = make_line_parameters<Point, Calc>(line_a, line_b);
+    assert(sign_value(line.direction_x) != 0 ||
+           sign_value(line.direction_y) != 0);
+
+    if (hull.size() <= 2) {
+        return line_degenerate_convex_hull_intersection<Point, Calc>(hull,
+                                                                     line);
+    }
+
+    return line_strict_convex_polygon_intersection<Point, Calc>(hull, line);
+}
+} // namespace line_convex_polygon_intersection_internal
+
 template <class Point, class Calc = void>
 LineConvexHullIntersectionResult<Point, Calc>
 line_convex_hull_intersection(const std::vector<Point> &hull,
@@ -682,19 +725,41 @@ line_convex_hull_intersection(const std::vector<Point> &hull,
                       lpi_internal::is_signed_v<Number>,
                   "integer calculation type must be signed");
 
-    const auto line =
-        lpi_internal::make_line_parameters<Point, Number>(line_a, line_b);
-    assert(lpi_internal::sign_value(line.direction_x) != 0 ||
-           lpi_internal::sign_value(line.direction_y) != 0);
-
-    if (hull.size() <= 2) {
-        return lpi_internal::line_degenerate_convex_hull_intersection<Point,
-                                                                      Number>(
-            hull, line);
+    if constexpr (std::is_void_v<Calc> &&
+                  lpi_internal::use_int128_by_default_v<Coord>) {
+        // まず 64 bit 整数でオーバーフローを検出しながら計算する。
+        using Checked = NicheLibrary::CheckedInt<std::int64_t>;
+        const NicheLibrary::CheckedIntOverflowScope scope;
+        if (!hull.empty()) {
+            // 頂点の高さと頂点数の積が収まらない場合は途中でオーバーフローする
+            // 可能性が高いため、64 bit での計算を試さない。
+            const auto line =
+                lpi_internal::make_line_parameters<Point, Checked>(line_a,
+                                                                   line_b);
+            static_cast<void>(
+                lpi_internal::line_height<Point, Checked>(hull[0], line) *
+                Checked(hull.size()));
+        }
+        if (!scope.overflowed()) {
+            const auto checked_result =
+                lpi_internal::line_convex_hull_intersection_with<Point,
+                                                                 Checked>(
+                    hull, line_a, line_b);
+            if (!scope.overflowed()) {
+                LineConvexHullIntersectionResult<Point, Calc> result;
+                result.reserve(checked_result.size());
+                for (const auto &point : checked_result) {
+                    result.push_back({Number(point.x_numerator.value()),
+                                      Number(point.y_numerator.value()),
+                                      Number(point.denominator.value())});
+                }
+                return result;
+            }
+        }
     }
 
-    return lpi_internal::line_strict_convex_polygon_intersection<Point, Number>(
-        hull, line);
+    return lpi_internal::line_convex_hull_intersection_with<Point, Number>(
+        hull, line_a, line_b);
 }
 
 template <class Point, class Calc = void>
@@ -0,0 +1,299 @@
+#ifndef INTERNAL_CHECKED_ARITHMETIC_HPP
+#define INTERNAL_CHECKED_ARITHMETIC_HPP
+
+// 組み込みの整数型に対する、オーバーフローを検出する加算、減算、乗算。
+// 結果を 2^w を法として result に格納し（w は型のビット幅）、オーバーフローしたかどうかを返す。
+// 処理系が __builtin_add_overflow などを提供する場合はそれを用い、そうでない場合は移植性のある実装を用いる。
+// NICHE_LIBRARY_CHECKED_ARITHMETIC_PORTABLE を include より前に定義すると、常に移植性のある実装を使う。
+// また、演算のたびにオーバーフローを検出し、スレッドごとのフラグに記録する整数型 CheckedInt を提供する。
+// 小さい型で計算を試み、オーバーフローした場合にのみ大きい型で計算し直す用途を想定している。
+
+#include <compare>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if !defined(NICHE_LIBRARY_CHECKED_ARITHMETIC_PORTABLE) &&                    \
+    defined(__has_builtin)
+#if __has_builtin(__builtin_add_overflow) &&                                   \
+    __has_builtin(__builtin_sub_overflow) &&                                   \
+    __has_builtin(__builtin_mul_overflow)
+#define NICHE_LIBRARY_CHECKED_ARITHMETIC_USE_BUILTIN
+#endif
+#endif
+
+namespace NicheLibrary {
+namespace checked_arithmetic_internal {
+template <class T>
+constexpr bool is_checked_integer_v =
+    std::is_integral_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+template <class T>
+constexpr bool portable_add_overflow(T lhs, T rhs, T &result) {
+    using U = std::make_unsigned_t<T>;
+    result = static_cast<T>(static_cast<U>(lhs) + static_cast<U>(rhs));
+    if constexpr (std::is_signed_v<T>) {
+        return ((lhs ^ result) & (rhs ^ result)) < 0;
+    } else {
+        return result < lhs;
+    }
+}
+
+template <class T>
+constexpr bool portable_sub_overflow(T lhs, T rhs, T &result) {
+    using U = std::make_unsigned_t<T>;
+    result = static_cast<T>(static_cast<U>(lhs) - static_cast<U>(rhs));
+    if constexpr (std::is_signed_v<T>) {
+        return ((lhs ^ rhs) & (lhs ^ result)) < 0;
+    } else {
+        return lhs < rhs;
+    }
+}
+
+template <class T>
+constexpr bool portable_mul_overflow(T lhs, T rhs, T &result) {
+    using U = std::make_unsigned_t<T>;
+    if constexpr (std::is_signed_v<T>) {
+        const bool negative = (lhs < 0) != (rhs < 0);
+        const U lhs_abs = lhs < 0 ? U(0) - static_cast<U>(lhs) : U(lhs);
+        const U rhs_abs = rhs < 0 ? U(0) - static_cast<U>(rhs) : U(rhs);
+        U product = 0;
+        const bool unsigned_overflow =
+            portable_mul_overflow<U>(lhs_abs, rhs_abs, product);
+        const U limit = static_cast<U>(std::numeric_limits<T>::max()) +
+                        (negative ? U(1) : U(0));
+        result = static_cast<T>(negative ? U(0) - product : product);
+        return unsigned_overflow || product > limit;
+    } else {
+        // 整数昇格により符号付きの演算にならないよう、unsigned int 以上で計算する。
+        using W = std::common_type_t<U, unsigned int>;
+        result = static_cast<T>(static_cast<W>(lhs) * static_cast<W>(rhs));
+        return lhs != 0 && rhs > std::numeric_limits<T>::max() / lhs;
+    }
+}
+
+inline thread_local bool overflow_flag = false;
+} // namespace checked_arithmetic_internal
+
+// lhs + rhs を result に格納し、オーバーフローした場合に true を返す。
+template <class T> constexpr bool add_overflow(T lhs, T rhs, T &result) {
+    static_assert(checked_arithmetic_internal::is_checked_integer_v<T>,
+                  "T must be a built-in integer type other than bool.");
+#ifdef NICHE_LIBRARY_CHECKED_ARITHMETIC_USE_BUILTIN
+    return __builtin_add_overflow(lhs, rhs, &result);
+#else
+    return checked_arithmetic_internal::portable_add_overflow(lhs, rhs,
+                                                              result);
+#endif
+}
+
+// lhs - rhs を result に格納し、オーバーフローした場合に true を返す。
+template <class T> constexpr bool sub_overflow(T lhs, T rhs, T &result) {
+    static_assert(checked_arithmetic_internal::is_checked_integer_v<T>,
+                  "T must be a built-in integer type other than bool.");
+#ifdef NICHE_LIBRARY_CHECKED_ARITHMETIC_USE_BUILTIN
+    return __builtin_sub_overflow(lhs, rhs, &result);
+#else
+    return checked_arithmetic_internal::portable_sub_overflow(lhs, rhs,
+                                                              result);
+#endif
+}
+
+// lhs rhs を result に格納し、オーバーフローした場合に true を返す。
+template <class T> constexpr bool mul_overflow(T lhs, T rhs, T &result) {
+    static_assert(checked_arithmetic_internal::is_checked_integer_v<T>,
+                  "T must be a built-in integer type other than bool.");
+#ifdef NICHE_LIBRARY_CHECKED_ARITHMETIC_USE_BUILTIN
+    return __builtin_mul_overflow(lhs, rhs, &result);
+#else
+    return checked_arithmetic_internal::portable_mul_overflow(lhs, rhs,
+                                                              result);
+#endif
+}
+
+// 生存期間中に CheckedInt の演算でオーバーフローが起きたかどうかを調べる。
+// 構築時にスレッドのフラグを退避して下ろし、破棄時に元に戻すため、入れ子にしてもよい。
+class CheckedIntOverflowScope {
+  public:
+    CheckedIntOverflowScope()
+        : saved_(std::exchange(checked_arithmetic_internal::overflow_flag,
+                               false)) {}
+
+    CheckedIntOverflowScope(const CheckedIntOverflowScope &) = delete;
+    CheckedIntOverflowScope &
+    operator=(const CheckedIntOverflowScope &) = delete;
+
+    ~CheckedIntOverflowScope() {
+        checked_arithmetic_internal::overflow_flag = saved_;
+    }
+
+    bool overflowed() const { return flag(); }
+
+    // 現在のスレッドのフラグを返す。
+    static bool flag() { return checked_arithmetic_internal::overflow_flag; }
+
+  private:
+    bool saved_;
+};
+
+// 演算のたびにオーバーフローを検出する整数型。
+// オーバーフローした場合はスレッドのフラグを立て、2^w を法とした値を保持して計算を続ける。
+// 0 による除算もオーバーフローとして扱い、商と剰余を 0 とする。
+template <class T> class CheckedInt {
+    static_assert(checked_arithmetic_internal::is_checked_integer_v<T>,
+                  "T must be a built-in integer type other than bool.");
+
+  public:
+    using value_type = T;
+
+    constexpr CheckedInt() = default;
+
+    template <class U,
+              std::enable_if_t<
+                  checked_arithmetic_internal::is_checked_integer_v<U>, int> =
+                  0>
+    constexpr CheckedInt(U value) : value_(static_cast<T>(value)) {
+        if (!std::in_range<T>(value)) {
+            report_overflow();
+        }
+    }
+
+    constexpr T value() const { return value_; }
+
+    template <class U, std::enable_if_t<std::is_integral_v<U>, int> = 0>
+    explicit constexpr operator U() const {
+        return static_cast<U>(value_);
+    }
+
+    constexpr CheckedInt &operator+=(const CheckedInt &rhs) {
+        if (add_overflow(value_, rhs.value_, value_)) {
+            report_overflow();
+        }
+        return *this;
+    }
+
+    constexpr CheckedInt &operator-=(const CheckedInt &rhs) {
+        if (sub_overflow(value_, rhs.value_, value_)) {
+            report_overflow();
+        }
+        return *this;
+    }
+
+    constexpr CheckedInt &operator*=(const CheckedInt &rhs) {
+        if (mul_overflow(value_, rhs.value_, value_)) {
+            report_overflow();
+        }
+        return *this;
+    }
+
+    constexpr CheckedInt &operator/=(const CheckedInt &rhs) {
+        if (is_invalid_division(rhs.value_)) {
+            report_overflow();
+            value_ = rhs.value_ == 0 ? T(0) : value_;
+        } else {
+            value_ /= rhs.value_;
+        }
+        return *this;
+    }
+
+    constexpr CheckedInt &operator%=(const CheckedInt &rhs) {
+        if (is_invalid_division(rhs.value_)) {
+            report_overflow();
+            value_ = 0;
+        } else {
+            value_ %= rhs.value_;
+        }
+        return *this;
+    }
+
+    constexpr CheckedInt operator+() const { return *this; }
+
+    constexpr CheckedInt operator-() const { return CheckedInt() - *this; }
+
+    friend constexpr CheckedInt operator+(CheckedInt lhs,
+                                          const CheckedInt &rhs) {
+        return lhs += rhs;
+    }
+
+    friend constexpr CheckedInt operator-(CheckedInt lhs,
+                                          const CheckedInt &rhs) {
+        return lhs -= rhs;
+    }
+
+    friend constexpr CheckedInt operator*(CheckedInt lhs,
+                                          const CheckedInt &rhs) {
+        return lhs *= rhs;
+    }
+
+    friend constexpr CheckedInt operator/(CheckedInt lhs,
+                                          const CheckedInt &rhs) {
+        return lhs /= rhs;
+    }
+
+    friend constexpr CheckedInt operator%(CheckedInt lhs,
+                                          const CheckedInt &rhs) {
+        return lhs %= rhs;
+    }
+
+    friend constexpr bool operator==(const CheckedInt &lhs,
+                                     const CheckedInt &rhs) {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend constexpr auto operator<=>(const CheckedInt &lhs,
+                                      const CheckedInt &rhs) {
+        return lhs.value_ <=> rhs.value_;
+    }
+
+  private:
+    T value_ = 0;
+
+    static void report_overflow() {
+        checked_arithmetic_internal::overflow_flag = true;
+    }
+
+    constexpr bool is_invalid_division(T rhs) const {
+        if (rhs == 0) {
+            return true;
+        }
+        if constexpr (std::is_signed_v<T>) {
+            return rhs == T(-1) && value_ == std::numeric_limits<T>::min();
+        } else {
+            return false;
+        }
+    }
+};
+
+template <class T> struct is_checked_int : std::false_type {};
+
+template <class T> struct is_checked_int<CheckedInt<T>> : std::true_type {};
+
+template <class T>
+constexpr bool is_checked_int_v = is_checked_int<std::remove_cv_t<T>>::value;
+} // namespace NicheLibrary
+
+namespace std {
+template <class T> struct numeric_limits<NicheLibrary::CheckedInt<T>> {
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = numeric_limits<T>::is_signed;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr int digits = numeric_limits<T>::digits;
+    static constexpr int digits10 = numeric_limits<T>::digits10;
+    static constexpr int radix = 2;
+
+    static constexpr NicheLibrary::CheckedInt<T> min() noexcept {
+        return numeric_limits<T>::min();
+    }
+
+    static constexpr NicheLibrary::CheckedInt<T> lowest() noexcept {
+        return numeric_limits<T>::lowest();
+    }
+
+    static constexpr NicheLibrary::CheckedInt<T> max() noexcept {
+        return numeric_limits<T>::max();
+    }
+};
+} // namespace std
+
+#endif
@@ -0,0 +1,818 @@
+#ifndef INTERNAL_FIXED_WIDTH_INT_HPP
+#define INTERNAL_FIXED_WIDTH_INT_HPP
+
+// 64 Words bit 符号なし整数型 UIntN<Words> と 64 Words bit 符号付き整数型 IntN<Words> を提供する。
+// UInt128, Int128 と同じ設計であり、ヒープ領域を使わず、すべての演算は constexpr である。
+// UInt192, Int192, UInt256, Int256 はそれぞれ 3 語、4 語の別名である。
+// 除算は 64 bit の語を用いた Knuth の長除算で行う。
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <system_error>
+#include <type_traits>
+
+#include "int128.hpp"
+
+namespace NicheLibrary {
+template <std::size_t Words> class UIntN {
+    static_assert(Words >= 2, "UIntN must have at least 2 words.");
+
+  public:
+    using word_array = std::array<std::uint64_t, Words>;
+
+    constexpr UIntN() = default;
+
+    template <
+        class T,
+        std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T>, int> = 0>
+    constexpr UIntN(T value) {
+        words_[0] = static_cast<std::uint64_t>(value);
+        for (std::size_t i = 1; i < Words; ++i) {
+            words_[i] = value < 0 ? ~std::uint64_t{} : std::uint64_t{};
+        }
+    }
+
+    template <class T,
+              std::enable_if_t<std::is_integral_v<T> && !std::is_signed_v<T>,
+                               int> = 0>
+    constexpr UIntN(T value) {
+        words_[0] = static_cast<std::uint64_t>(value);
+    }
+
+    constexpr UIntN(UInt128 value) {
+        words_[0] = value.low();
+        words_[1] = value.high();
+    }
+
+    // words[0] が最下位の語である。
+    static constexpr UIntN from_words(const word_array &words) {
+        UIntN value;
+        value.words_ = words;
+        return value;
+    }
+
+    constexpr const word_array &words() const { return words_; }
+
+    constexpr std::uint64_t word(std::size_t index) const {
+        return words_[index];
+    }
+
+    template <class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    explicit constexpr operator T() const {
+        return static_cast<T>(words_[0]);
+    }
+
+    explicit constexpr operator UInt128() const {
+        return UInt128::from_words(words_[1], words_[0]);
+    }
+
+    explicit constexpr operator bool() const { return *this != UIntN{}; }
+
+    explicit constexpr operator long double() const {
+        long double result = 0;
+        for (std::size_t i = Words; i-- > 0;) {
+            result = result * 0x1p64L + static_cast<long double>(words_[i]);
+        }
+        return result;
+    }
+
+    friend constexpr bool operator==(const UIntN &lhs, const UIntN &rhs) {
+        return lhs.words_ == rhs.words_;
+    }
+
+    friend constexpr bool operator!=(const UIntN &lhs, const UIntN &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const UIntN &lhs, const UIntN &rhs) {
+        for (std::size_t i = Words; i-- > 0;) {
+            if (lhs.words_[i] != rhs.words_[i]) {
+                return lhs.words_[i] < rhs.words_[i];
+            }
+        }
+        return false;
+    }
+
+    friend constexpr bool operator>(const UIntN &lhs, const UIntN &rhs) {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const UIntN &lhs, const UIntN &rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const UIntN &lhs, const UIntN &rhs) {
+        return !(lhs < rhs);
+    }
+
+    constexpr UIntN operator+() const { return *this; }
+
+    constexpr UIntN operator-() const { return UIntN{} - *this; }
+
+    constexpr UIntN &operator+=(const UIntN &rhs) {
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < Words; ++i) {
+            const std::uint64_t sum = words_[i] + rhs.words_[i];
+            const std::uint64_t next_carry = sum < words_[i] ? 1 : 0;
+            words_[i] = sum + carry;
+            carry = next_carry + (words_[i] < sum ? 1 : 0);
+        }
+        return *this;
+    }
+
+    constexpr UIntN &operator-=(const UIntN &rhs) {
+        std::uint64_t borrow = 0;
+        for (std::size_t i = 0; i < Words; ++i) {
+            const std::uint64_t difference = words_[i] - rhs.words_[i];
+            const std::uint64_t next_borrow =
+                words_[i] < rhs.words_[i] ? 1 : 0;
+            words_[i] = difference - borrow;
+            borrow = next_borrow + (difference < borrow ? 1 : 0);
+        }
+        return *this;
+    }
+
+    constexpr UIntN &operator*=(const UIntN &rhs) {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    constexpr UIntN &operator/=(const UIntN &rhs) {
+        *this = *this / rhs;
+        return *this;
+    }
+
+    constexpr UIntN &operator%=(const UIntN &rhs) {
+        *this = *this % rhs;
+        return *this;
+    }
+
+    friend constexpr UIntN operator+(UIntN lhs, const UIntN &rhs) {
+        lhs += rhs;
+        return lhs;
+    }
+
+    friend constexpr UIntN operator-(UIntN lhs, const UIntN &rhs) {
+        lhs -= rhs;
+        return lhs;
+    }
+
+    friend constexpr UIntN operator*(const UIntN &lhs, const UIntN &rhs) {
+        UIntN result;
+        for (std::size_t i = 0; i < Words; ++i) {
+            if (lhs.words_[i] == 0) {
+                continue;
+            }
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; i + j < Words; ++j) {
+                const UInt128 product =
+                    UInt128::multiply_u64(lhs.words_[i], rhs.words_[j]) +
+                    UInt128(result.words_[i + j]) + UInt128(carry);
+                result.words_[i + j] = product.low();
+                carry = product.high();
+            }
+        }
+        return result;
+    }
+
+    static constexpr void div_mod(const UIntN &lhs, const UIntN &rhs,
+                                  UIntN &quotient, UIntN &remainder) {
+        assert(rhs != UIntN{});
+        div_mod_unchecked(lhs, rhs, quotient, remainder);
+    }
+
+    friend constexpr UIntN operator/(const UIntN &lhs, const UIntN &rhs) {
+        UIntN quotient;
+        UIntN remainder;
+        div_mod(lhs, rhs, quotient, remainder);
+        return quotient;
+    }
+
+    friend constexpr UIntN operator%(const UIntN &lhs, const UIntN &rhs) {
+        UIntN quotient;
+        UIntN remainder;
+        div_mod(lhs, rhs, quotient, remainder);
+        return remainder;
+    }
+
+  private:
+    template <std::size_t> friend class IntN;
+
+    static constexpr std::size_t word_length(const word_array &words) {
+        std::size_t length = Words;
+        while (length > 0 && words[length - 1] == 0) {
+            --length;
+        }
+        return length;
+    }
+
+    // 除数が 1 語の場合の除算。
+    static constexpr void div_mod_word(const UIntN &lhs, std::uint64_t rhs,
+                                       UIntN &quotient, UIntN &remainder) {
+        UIntN q;
+        std::uint64_t r = 0;
+        for (std::size_t i = Words; i-- > 0;) {
+            if (r == 0 && lhs.words_[i] < rhs) {
+                r = lhs.words_[i];
+                continue;
+            }
+            UInt128 word_quotient;
+            UInt128 word_remainder;
+            UInt128::div_mod(UInt128::from_words(r, lhs.words_[i]),
+                             UInt128(rhs), word_quotient, word_remainder);
+            q.words_[i] = word_quotient.low();
+            r = word_remainder.low();
+        }
+        quotient = q;
+        remainder = UIntN(r);
+    }
+
+    static constexpr void div_mod_unchecked(const UIntN &lhs, const UIntN &rhs,
+                                            UIntN &quotient,
+                                            UIntN &remainder) {
+        if (lhs < rhs) {
+            remainder = lhs;
+            quotient = UIntN{};
+            return;
+        }
+
+        const std::size_t n = word_length(rhs.words_);
+        if (n == 1) {
+            div_mod_word(lhs, rhs.words_[0], quotient, remainder);
+            return;
+        }
+        const std::size_t m = word_length(lhs.words_);
+
+        // 除数の最上位の語の最上位 bit が立つように正規化する。
+        const int shift = std::countl_zero(rhs.words_[n - 1]);
+        std::array<std::uint64_t, Words> v{};
+        std::array<std::uint64_t, Words + 1> u{};
+        for (std::size_t i = 0; i < n; ++i) {
+            v[i] = rhs.words_[i] << shift;
+            if (shift != 0 && i > 0) {
+                v[i] |= rhs.words_[i - 1] >> (64 - shift);
+            }
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            u[i] |= lhs.words_[i] << shift;
+            if (shift != 0) {
+                u[i + 1] = lhs.words_[i] >> (64 - shift);
+            }
+        }
+
+        UIntN q;
+        for (std::size_t j = m - n + 1; j-- > 0;) {
+            UInt128 q_hat;
+            UInt128 r_hat;
+            UInt128::div_mod(UInt128::from_words(u[j + n], u[j + n - 1]),
+                             UInt128(v[n - 1]), q_hat, r_hat);
+            while (q_hat.high() != 0 ||
+                   UInt128::multiply_u64(q_hat.low(), v[n - 2]) >
+                       UInt128::from_words(r_hat.low(), u[j + n - 2])) {
+                q_hat -= UInt128(1);
+                r_hat += UInt128(v[n - 1]);
+                if (r_hat.high() != 0) {
+                    break;
+                }
+            }
+
+            std::uint64_t carry = 0;
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i <= n; ++i) {
+                std::uint64_t subtrahend = carry;
+                if (i < n) {
+                    const UInt128 product =
+                        UInt128::multiply_u64(q_hat.low(), v[i]) +
+                        UInt128(carry);
+                    subtrahend = product.low();
+                    carry = product.high();
+                }
+                const std::uint64_t difference = u[i + j] - subtrahend;
+                const std::uint64_t next_borrow =
+                    (u[i + j] < subtrahend ? 1 : 0) +
+                    (difference < borrow ? 1 : 0);
+                u[i + j] = difference - borrow;
+                borrow = next_borrow;
+            }
+
+            if (borrow != 0) {
+                q_hat -= UInt128(1);
+                std::uint64_t add_carry = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    const std::uint64_t sum = u[i + j] + v[i];
+                    const std::uint64_t next_carry = sum < v[i] ? 1 : 0;
+                    u[i + j] = sum + add_carry;
+                    add_carry = next_carry + (u[i + j] < sum ? 1 : 0);
+                }
+                u[j + n] += add_carry;
+            }
+            q.words_[j] = q_hat.low();
+        }
+
+        UIntN r;
+        for (std::size_t i = 0; i < n; ++i) {
+            r.words_[i] = u[i] >> shift;
+            if (shift != 0) {
+                r.words_[i] |= u[i + 1] << (64 - shift);
+            }
+        }
+        quotient = q;
+        remainder = r;
+    }
+
+    word_array words_{};
+};
+
+template <std::size_t Words> class IntN {
+  public:
+    using word_array = typename UIntN<Words>::word_array;
+
+    constexpr IntN() = default;
+
+    template <class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    constexpr IntN(T value) : value_(value) {}
+
+    constexpr IntN(Int128 value)
+        : value_(UInt128::from_words(value.high(), value.low())) {
+        if (value.is_negative()) {
+            for (std::size_t i = 2; i < Words; ++i) {
+                value_.words_[i] = ~std::uint64_t{};
+            }
+        }
+    }
+
+    // 2 の補数表現で、words[0] が最下位の語である値を返す。
+    static constexpr IntN from_words(const word_array &words) {
+        return from_twos_complement(UIntN<Words>::from_words(words));
+    }
+
+    constexpr const word_array &words() const { return value_.words(); }
+
+    constexpr std::uint64_t word(std::size_t index) const {
+        return value_.word(index);
+    }
+
+    template <class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    explicit constexpr operator T() const {
+        return static_cast<T>(value_.word(0));
+    }
+
+    explicit constexpr operator Int128() const {
+        return Int128::from_words(value_.word(1), value_.word(0));
+    }
+
+    explicit constexpr operator bool() const {
+        return value_ != UIntN<Words>{};
+    }
+
+    constexpr bool is_negative() const {
+        return (value_.word(Words - 1) >> 63) != 0;
+    }
+
+    explicit constexpr operator long double() const {
+        if (is_negative()) {
+            return -static_cast<long double>(abs_unsigned(*this));
+        }
+        return static_cast<long double>(value_);
+    }
+
+    friend constexpr bool operator==(const IntN &lhs, const IntN &rhs) {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend constexpr bool operator!=(const IntN &lhs, const IntN &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const IntN &lhs, const IntN &rhs) {
+        const bool lhs_negative = lhs.is_negative();
+        const bool rhs_negative = rhs.is_negative();
+        if (lhs_negative != rhs_negative) {
+            return lhs_negative;
+        }
+        return lhs.value_ < rhs.value_;
+    }
+
+    friend constexpr bool operator>(const IntN &lhs, const IntN &rhs) {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const IntN &lhs, const IntN &rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const IntN &lhs, const IntN &rhs) {
+        return !(lhs < rhs);
+    }
+
+    constexpr IntN operator+() const { return *this; }
+
+    constexpr IntN operator-() const {
+        assert(*this != min_value());
+        return from_twos_complement(-value_);
+    }
+
+    constexpr IntN &operator+=(const IntN &rhs) {
+        value_ += rhs.value_;
+        return *this;
+    }
+
+    constexpr IntN &operator-=(const IntN &rhs) {
+        value_ -= rhs.value_;
+        return *this;
+    }
+
+    constexpr IntN &operator*=(const IntN &rhs) {
+        value_ *= rhs.value_;
+        return *this;
+    }
+
+    constexpr IntN &operator/=(const IntN &rhs) {
+        *this = *this / rhs;
+        return *this;
+    }
+
+    constexpr IntN &operator%=(const IntN &rhs) {
+        *this = *this % rhs;
+        return *this;
+    }
+
+    friend constexpr IntN operator+(IntN lhs, const IntN &rhs) {
+        lhs += rhs;
+        return lhs;
+    }
+
+    friend constexpr IntN operator-(IntN lhs, const IntN &rhs) {
+        lhs -= rhs;
+        return lhs;
+    }
+
+    friend constexpr IntN operator*(IntN lhs, const IntN &rhs) {
+        lhs *= rhs;
+        return lhs;
+    }
+
+    static constexpr void div_mod(const IntN &lhs, const IntN &rhs,
+                                  IntN &quotient, IntN &remainder) {
+        assert(rhs != IntN{});
+        assert(!(lhs == min_value() && rhs == IntN(-1)));
+
+        const bool lhs_negative = lhs.is_negative();
+        const bool rhs_negative = rhs.is_negative();
+
+        UIntN<Words> quotient_abs;
+        UIntN<Words> remainder_abs;
+        UIntN<Words>::div_mod_unchecked(abs_unsigned(lhs), abs_unsigned(rhs),
+                                        quotient_abs, remainder_abs);
+
+        quotient = from_unsigned_unchecked(quotient_abs,
+                                           lhs_negative != rhs_negative);
+        remainder = from_unsigned_unchecked(remainder_abs, lhs_negative);
+    }
+
+    friend constexpr IntN operator/(const IntN &lhs, const IntN &rhs) {
+        IntN quotient;
+        IntN remainder;
+        div_mod(lhs, rhs, quotient, remainder);
+        return quotient;
+    }
+
+    friend constexpr IntN operator%(const IntN &lhs, const IntN &rhs) {
+        IntN quotient;
+        IntN remainder;
+        div_mod(lhs, rhs, quotient, remainder);
+        return remainder;
+    }
+
+  private:
+    static constexpr IntN from_twos_complement(const UIntN<Words> &value) {
+        IntN result;
+        result.value_ = value;
+        return result;
+    }
+
+    static constexpr IntN min_value() {
+        word_array words{};
+        words[Words - 1] = std::uint64_t{1} << 63;
+        return from_words(words);
+    }
+
+    static constexpr UIntN<Words> abs_unsigned(const IntN &value) {
+        if (!value.is_negative()) {
+            return value.value_;
+        }
+        return -value.value_;
+    }
+
+    // 引数 negative で指定した通りに符号を付けた value が
+    // IntN の範囲に収まることを仮定する。
+    static constexpr IntN from_unsigned_unchecked(const UIntN<Words> &value,
+                                                  bool negative) {
+        return from_twos_complement(negative ? -value : value);
+    }
+
+    template <std::size_t W>
+    friend std::from_chars_result from_chars(const char *first,
+                                             const char *last, IntN<W> &value);
+    template <std::size_t W>
+    friend std::to_chars_result to_chars(char *first, char *last,
+                                         const IntN<W> &value);
+
+    UIntN<Words> value_;
+};
+
+using UInt192 = UIntN<3>;
+using Int192 = IntN<3>;
+using UInt256 = UIntN<4>;
+using Int256 = IntN<4>;
+
+namespace fixed_width_int_internal {
+// words = words mul + add とし、最上位からあふれた語を返す。
+template <std::size_t Words>
+constexpr std::uint64_t
+multiply_add_word(std::array<std::uint64_t, Words> &words, std::uint64_t mul,
+                  std::uint64_t add) {
+    std::uint64_t carry = add;
+    for (std::uint64_t &word : words) {
+        const UInt128 product =
+            UInt128::multiply_u64(word, mul) + UInt128(carry);
+        word = product.low();
+        carry = product.high();
+    }
+    return carry;
+}
+
+// [first, last) がすべて数字であることを仮定する。
+// 表す値が UIntN<Words> の範囲に収まらない場合は false を返す。
+template <std::size_t Words>
+bool parse_digits(const char *first, const char *last, UIntN<Words> &value) {
+    namespace i128 = int128_internal;
+    std::array<std::uint64_t, Words> words{};
+    std::ptrdiff_t chunk = (last - first) % 19;
+    if (chunk == 0) {
+        chunk = 19;
+    }
+    std::uint64_t scale = 1;
+    for (std::ptrdiff_t i = 0; i < chunk; ++i) {
+        scale *= 10;
+    }
+    while (first != last) {
+        const std::uint64_t digits = i128::parse_digits(first, chunk);
+        if (multiply_add_word(words, scale, digits) != 0) {
+            return false;
+        }
+        first += chunk;
+        chunk = 19;
+        scale = i128::pow10_19;
+    }
+    value = UIntN<Words>::from_words(words);
+    return true;
+}
+
+// value の 10 進法表記を end の直前から書き込み、書き込んだ先頭を返す。
+// end の直前に 20 Words 文字分の領域があることを仮定する。
+template <std::size_t Words>
+char *write_backward(char *end, UIntN<Words> value) {
+    namespace i128 = int128_internal;
+    const UIntN<Words> base = UIntN<Words>(i128::pow10_19);
+    while (value >= base) {
+        UIntN<Words> quotient;
+        UIntN<Words> remainder;
+        UIntN<Words>::div_mod(value, base, quotient, remainder);
+        end = i128::write_padded_19_backward(end, remainder.word(0));
+        value = quotient;
+    }
+    return i128::write_digits_backward(end, value.word(0));
+}
+} // namespace fixed_width_int_internal
+
+template <std::size_t Words>
+std::from_chars_result from_chars(const char *first, const char *last,
+                                  UIntN<Words> &value) {
+    const char *digits_last = int128_internal::skip_digits(first, last);
+    if (digits_last == first) {
+        return {first, std::errc::invalid_argument};
+    }
+    const char *digits_first = first;
+    while (digits_first != digits_last && *digits_first == '0') {
+        ++digits_first;
+    }
+    UIntN<Words> parsed;
+    if (!fixed_width_int_internal::parse_digits(digits_first, digits_last,
+                                                parsed)) {
+        return {digits_last, std::errc::result_out_of_range};
+    }
+    value = parsed;
+    return {digits_last, std::errc{}};
+}
+
+template <std::size_t Words>
+std::from_chars_result from_chars(const char *first, const char *last,
+                                  IntN<Words> &value) {
+    const bool negative = first != last && *first == '-';
+    UIntN<Words> magnitude;
+    const std::from_chars_result result =
+        from_chars(negative ? first + 1 : first, last, magnitude);
+    if (result.ec == std::errc::invalid_argument) {
+        return {first, std::errc::invalid_argument};
+    }
+    if (result.ec != std::errc{}) {
+        return result;
+    }
+    const UIntN<Words> limit = IntN<Words>::min_value().value_;
+    if (negative ? magnitude > limit : magnitude >= limit) {
+        return {result.ptr, std::errc::result_out_of_range};
+    }
+    value = IntN<Words>::from_unsigned_unchecked(magnitude, negative);
+    return result;
+}
+
+template <std::size_t Words>
+std::to_chars_result to_chars(char *first, char *last,
+                              const UIntN<Words> &value) {
+    char buffer[20 * Words];
+    char *const end = buffer + 20 * Words;
+    return int128_internal::copy_chars(
+        first, last, fixed_width_int_internal::write_backward(end, value),
+        end);
+}
+
+template <std::size_t Words>
+std::to_chars_result to_chars(char *first, char *last,
+                              const IntN<Words> &value) {
+    char buffer[20 * Words + 1];
+    char *const end = buffer + 20 * Words + 1;
+    char *begin = fixed_width_int_internal::write_backward(
+        end, IntN<Words>::abs_unsigned(value));
+    if (value.is_negative()) {
+        *--begin = '-';
+    }
+    return int128_internal::copy_chars(first, last, begin, end);
+}
+
+template <std::size_t Words>
+std::istream &operator>>(std::istream &input, UIntN<Words> &value) {
+    int128_internal::read_decimal(input, value);
+    return input;
+}
+
+template <std::size_t Words>
+std::ostream &operator<<(std::ostream &output, const UIntN<Words> &value) {
+    char buffer[20 * Words];
+    const std::to_chars_result result =
+        to_chars(buffer, buffer + 20 * Words, value);
+    output.write(buffer, result.ptr - buffer);
+    return output;
+}
+
+template <std::size_t Words>
+std::istream &operator>>(std::istream &input, IntN<Words> &value) {
+    int128_internal::read_decimal(input, value);
+    return input;
+}
+
+template <std::size_t Words>
+std::ostream &operator<<(std::ostream &output, const IntN<Words> &value) {
+    char buffer[20 * Words + 1];
+    const std::to_chars_result result =
+        to_chars(buffer, buffer + 20 * Words + 1, value);
+    output.write(buffer, result.ptr - buffer);
+    return output;
+}
+} // namespace NicheLibrary
+
+namespace std {
+template <std::size_t Words> class numeric_limits<NicheLibrary::UIntN<Words>> {
+  public:
+    static constexpr bool is_specialized = true;
+
+    static constexpr NicheLibrary::UIntN<Words> min() noexcept { return 0; }
+    static constexpr NicheLibrary::UIntN<Words> max() noexcept {
+        return NicheLibrary::UIntN<Words>(-1);
+    }
+    static constexpr NicheLibrary::UIntN<Words> lowest() noexcept {
+        return 0;
+    }
+
+    static constexpr int digits = static_cast<int>(64 * Words);
+    static constexpr int digits10 = digits * 643 / 2136;
+    static constexpr int max_digits10 = 0;
+    static constexpr bool is_signed = false;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr int radix = 2;
+
+    static constexpr NicheLibrary::UIntN<Words> epsilon() noexcept {
+        return 0;
+    }
+    static constexpr NicheLibrary::UIntN<Words> round_error() noexcept {
+        return 0;
+    }
+
+    static constexpr int min_exponent = 0;
+    static constexpr int min_exponent10 = 0;
+    static constexpr int max_exponent = 0;
+    static constexpr int max_exponent10 = 0;
+
+    static constexpr bool has_infinity = false;
+    static constexpr bool has_quiet_NaN = false;
+    static constexpr bool has_signaling_NaN = false;
+    static constexpr float_denorm_style has_denorm = denorm_absent;
+    static constexpr bool has_denorm_loss = false;
+
+    static constexpr NicheLibrary::UIntN<Words> infinity() noexcept {
+        return 0;
+    }
+    static constexpr NicheLibrary::UIntN<Words> quiet_NaN() noexcept {
+        return 0;
+    }
+    static constexpr NicheLibrary::UIntN<Words> signaling_NaN() noexcept {
+        return 0;
+    }
+    static constexpr NicheLibrary::UIntN<Words> denorm_min() noexcept {
+        return 0;
+    }
+
+    static constexpr bool is_iec559 = false;
+    static constexpr bool is_bounded = true;
+    static constexpr bool is_modulo = true;
+    static constexpr bool traps = false;
+    static constexpr bool tinyness_before = false;
+    static constexpr float_round_style round_style = round_toward_zero;
+};
+
+template <std::size_t Words> class numeric_limits<NicheLibrary::IntN<Words>> {
+  public:
+    static constexpr bool is_specialized = true;
+
+    static constexpr NicheLibrary::IntN<Words> min() noexcept {
+        typename NicheLibrary::IntN<Words>::word_array words{};
+        words[Words - 1] = std::uint64_t{1} << 63;
+        return NicheLibrary::IntN<Words>::from_words(words);
+    }
+    static constexpr NicheLibrary::IntN<Words> max() noexcept {
+        typename NicheLibrary::IntN<Words>::word_array words{};
+        for (std::uint64_t &word : words) {
+            word = ~std::uint64_t{};
+        }
+        words[Words - 1] = (std::uint64_t{1} << 63) - 1;
+        return NicheLibrary::IntN<Words>::from_words(words);
+    }
+    static constexpr NicheLibrary::IntN<Words> lowest() noexcept {
+        return min();
+    }
+
+    static constexpr int digits = static_cast<int>(64 * Words - 1);
+    static constexpr int digits10 = digits * 643 / 2136;
+    static constexpr int max_digits10 = 0;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr int radix = 2;
+
+    static constexpr NicheLibrary::IntN<Words> epsilon() noexcept { return 0; }
+    static constexpr NicheLibrary::IntN<Words> round_error() noexcept {
+        return 0;
+    }
+
+    static constexpr int min_exponent = 0;
+    static constexpr int min_exponent10 = 0;
+    static constexpr int max_exponent = 0;
+    static constexpr int max_exponent10 = 0;
+
+    static constexpr bool has_infinity = false;
+    static constexpr bool has_quiet_NaN = false;
+    static constexpr bool has_signaling_NaN = false;
+    static constexpr float_denorm_style has_denorm = denorm_absent;
+    static constexpr bool has_denorm_loss = false;
+
+    static constexpr NicheLibrary::IntN<Words> infinity() noexcept {
+        return 0;
+    }
+    static constexpr NicheLibrary::IntN<Words> quiet_NaN() noexcept {
+        return 0;
+    }
+    static constexpr NicheLibrary::IntN<Words> signaling_NaN() noexcept {
+        return 0;
+    }
+    static constexpr NicheLibrary::IntN<Words> denorm_min() noexcept {
+        return 0;
+    }
+
+    static constexpr bool is_iec559 = false;
+    static constexpr bool is_bounded = true;
+    static constexpr bool is_modulo = false;
+    static constexpr bool traps = false;
+    static constexpr bool tinyness_before = false;
+    static constexpr float_round_style round_style = round_toward_zero;
+};
+} // namespace std
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef INTERNAL_INT_ONE_TWO_EIGHT_RADIX_SORT_HPP
+#define INTERNAL_INT_ONE_TWO_EIGHT_RADIX_SORT_HPP
+
+// UInt128 または Int128 の列を、上位の桁から順に分配する基数ソート（MSD）で昇順に並べる。
+// 8 bit ずつ 16 桁に分け、範囲内のすべての要素で値が等しい桁は分配を省略する。
+// Int128 では最上位の桁の符号 bit を反転して、2 の補数表現の順序を符号なしの順序に合わせる。
+// 要素数が少ない範囲は std::sort で並べる。
+// 計算量 O(n)（桁数 16 に比例する定数倍）、追加領域 O(n)。
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "int128.hpp"
+
+namespace NicheLibrary {
+namespace int128_radix_sort_internal {
+constexpr int radix_bits = 8;
+constexpr int radix_size = 1 << radix_bits;
+constexpr int digit_count = 128 / radix_bits;
+constexpr std::size_t small_size = 64;
+
+template <class T>
+constexpr std::size_t digit(const T &value, int index, bool flip_sign) {
+    const std::uint64_t word =
+        index < digit_count / 2 ? value.low() : value.high();
+    const int shift = (index % (digit_count / 2)) * radix_bits;
+    std::size_t result =
+        static_cast<std::size_t>((word >> shift) & (radix_size - 1));
+    if (flip_sign && index == digit_count - 1) {
+        result ^= radix_size / 2;
+    }
+    return result;
+}
+
+// [first, first + n) を上から index 番目までの桁で並べる。buffer は作業領域。
+template <class T>
+void sort_from(T *first, std::size_t n, T *buffer, int index,
+               bool flip_sign) {
+    while (n >= small_size && index >= 0) {
+        std::array<std::size_t, radix_size> count{};
+        for (std::size_t i = 0; i < n; ++i) {
+            ++count[digit(first[i], index, flip_sign)];
+        }
+        if (count[digit(first[0], index, flip_sign)] == n) {
+            --index;
+            continue;
+        }
+
+        std::array<std::size_t, radix_size + 1> start;
+        start[0] = 0;
+        for (int b = 0; b < radix_size; ++b) {
+            start[b + 1] = start[b] + count[b];
+        }
+        std::array<std::size_t, radix_size> position;
+        std::copy(start.begin(), start.end() - 1, position.begin());
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer[position[digit(first[i], index, flip_sign)]++] = first[i];
+        }
+        std::copy(buffer, buffer + n, first);
+
+        for (int b = 0; b < radix_size; ++b) {
+            const std::size_t size = start[b + 1] - start[b];
+            if (size > 1) {
+                sort_from(first + start[b], size, buffer + start[b],
+                          index - 1, flip_sign);
+            }
+        }
+        return;
+    }
+    std::sort(first, first + n);
+}
+
+template <class T> void sort(T *first, T *last, bool flip_sign) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    if (n < small_size) {
+        std::sort(first, last);
+        return;
+    }
+    std::vector<T> buffer(n);
+    sort_from(first, n, buffer.data(), digit_count - 1, flip_sign);
+}
+} // namespace int128_radix_sort_internal
+
+inline void radix_sort(UInt128 *first, UInt128 *last) {
+    int128_radix_sort_internal::sort(first, last, false);
+}
+
+inline void radix_sort(Int128 *first, Int128 *last) {
+    int128_radix_sort_internal::sort(first, last, true);
+}
+
+inline void radix_sort(std::vector<UInt128> &values) {
+    radix_sort(values.data(), values.data() + values.size());
+}
+
+inline void radix_sort(std::vector<Int128> &values) {
+    radix_sort(values.data(), values.data() + values.size());
+}
+} // namespace NicheLibrary
+
+#endif
@@ -3,15 +3,34 @@
 
 // 128 bit 符号なし整数型 UInt128 と 128 bit 符号付き整数型 Int128 を提供する。
 // GCC 拡張には依存しない。
-
+// ただし、処理系が unsigned __int128 を提供する場合は、実行時の乗算と除算にのみそれを用いる。
+// NICHE_LIBRARY_INT128_PORTABLE を定義すると、常に GCC 拡張を用いない実装を使う。
+// 定数式の評価では、常に GCC 拡張を用いない実装を使う。どちらの実装でも結果は一致する。
+// 10 進法表記の入出力は、メモリを確保しない from_chars, to_chars と、
+// 空白区切りの列をまとめて読む parse_int128_sequence, parse_uint128_sequence で行える。
+// std::hash を特殊化しているため、非順序連想コンテナのキーにできる。
+
+#include <array>
 #include <bit>
 #include <cassert>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <istream>
 #include <limits>
 #include <ostream>
 #include <string>
+#include <system_error>
 #include <type_traits>
+#include <vector>
+
+#if defined(__SIZEOF_INT128__) && !defined(NICHE_LIBRARY_INT128_PORTABLE)
+#define NICHE_LIBRARY_INT128_USE_BUILTIN 1
+#else
+#define NICHE_LIBRARY_INT128_USE_BUILTIN 0
+#endif
 
 namespace NicheLibrary {
 class UInt128 {
@@ -127,11 +146,39 @@ class UInt128 {
     }
 
     friend constexpr UInt128 operator*(UInt128 lhs, UInt128 rhs) {
+#if NICHE_LIBRARY_INT128_USE_BUILTIN
+        if (!std::is_constant_evaluated()) {
+            return from_builtin(to_builtin(lhs) * to_builtin(rhs));
+        }
+#endif
         const UInt128 p00 = multiply_u64(lhs.low_, rhs.low_);
         return from_words(
             p00.high_ + lhs.low_ * rhs.high_ + lhs.high_ * rhs.low_, p00.low_);
     }
 
+    static constexpr UInt128 multiply_u64(std::uint64_t lhs,
+                                          std::uint64_t rhs) {
+#if NICHE_LIBRARY_INT128_USE_BUILTIN
+        if (!std::is_constant_evaluated()) {
+            return from_builtin(static_cast<builtin_type>(lhs) * rhs);
+        }
+#endif
+        constexpr std::uint64_t mask = (std::uint64_t{1} << 32) - 1;
+        const std::uint64_t lhs_low = lhs & mask;
+        const std::uint64_t lhs_high = lhs >> 32;
+        const std::uint64_t rhs_low = rhs & mask;
+        const std::uint64_t rhs_high = rhs >> 32;
+
+        const std::uint64_t p00 = lhs_low * rhs_low;
+        const std::uint64_t p01 = lhs_low * rhs_high;
+        const std::uint64_t p10 = lhs_high * rhs_low;
+        const std::uint64_t p11 = lhs_high * rhs_high;
+
+        const std::uint64_t middle = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+        return from_words(p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32),
+                          (middle << 32) | (p00 & mask));
+    }
+
     static constexpr void div_mod(UInt128 lhs, UInt128 rhs, UInt128 &quotient,
                                   UInt128 &remainder) {
         assert(rhs != UInt128{});
@@ -155,6 +202,19 @@ class UInt128 {
   private:
     friend class Int128;
 
+#if NICHE_LIBRARY_INT128_USE_BUILTIN
+    __extension__ typedef unsigned __int128 builtin_type;
+
+    static constexpr builtin_type to_builtin(UInt128 value) {
+        return (static_cast<builtin_type>(value.high_) << 64) | value.low_;
+    }
+
+    static constexpr UInt128 from_builtin(builtin_type value) {
+        return from_words(static_cast<std::uint64_t>(value >> 64),
+                          static_cast<std::uint64_t>(value));
+    }
+#endif
+
     static constexpr std::uint64_t word_base() {
         return std::uint64_t{1} << 32;
     }
@@ -369,6 +429,17 @@ class UInt128 {
     static constexpr void div_mod_unchecked(UInt128 lhs, UInt128 rhs,
                                             UInt128 &quotient,
                                             UInt128 &remainder) {
+#if NICHE_LIBRARY_INT128_USE_BUILTIN
+        if (!std::is_constant_evaluated()) {
+            const builtin_type lhs_value = to_builtin(lhs);
+            const builtin_type rhs_value = to_builtin(rhs);
+            const UInt128 q = from_builtin(lhs_value / rhs_value);
+            const UInt128 r = from_builtin(lhs_value % rhs_value);
+            quotient = q;
+            remainder = r;
+            return;
+        }
+#endif
         UInt128 q, r;
         if (rhs.high_ == 0) {
             if (lhs.high_ == 0) {
@@ -395,24 +466,6 @@ class UInt128 {
         remainder = r;
     }
 
-    static constexpr UInt128 multiply_u64(std::uint64_t lhs,
-                                          std::uint64_t rhs) {
-        constexpr std::uint64_t mask = (std::uint64_t{1} << 32) - 1;
-        const std::uint64_t lhs_low = lhs & mask;
-        const std::uint64_t lhs_high = lhs >> 32;
-        const std::uint64_t rhs_low = rhs & mask;
-        const std::uint64_t rhs_high = rhs >> 32;
-
-        const std::uint64_t p00 = lhs_low * rhs_low;
-        const std::uint64_t p01 = lhs_low * rhs_high;
-        const std::uint64_t p10 = lhs_high * rhs_low;
-        const std::uint64_t p11 = lhs_high * rhs_high;
-
-        const std::uint64_t middle = (p00 >> 32) + (p01 & mask) + (p10 & mask);
-        return from_words(p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32),
-                          (middle << 32) | (p00 & mask));
-    }
-
     std::uint64_t high_ = 0;
     std::uint64_t low_ = 0;
 };
@@ -596,131 +649,339 @@ class Int128 {
         return from_twos_complement(negative ? -value : value);
     }
 
-    friend std::istream &operator>>(std::istream &input, Int128 &value);
-    friend std::ostream &operator<<(std::ostream &output, Int128 value);
+    friend std::from_chars_result from_chars(const char *first,
+                                             const char *last, Int128 &value);
+    friend std::to_chars_result to_chars(char *first, char *last,
+                                         Int128 value);
 
     UInt128 value_;
 };
 
 namespace int128_internal {
-// first < text.size() が呼び出し元で保証されていることを仮定する。
-inline UInt128 read_uint128_decimal(const std::string &text,
-                                    std::size_t first) {
-    UInt128 value = 0;
-
-    std::size_t i = first;
-    const std::size_t first_len = (text.size() - first) % 9;
-    if (first_len != 0) {
-        std::uint32_t chunk = 0;
-        for (std::size_t j = 0; j < first_len; ++j) {
-            assert('0' <= text[i] && text[i] <= '9');
-            chunk = chunk * 10 + static_cast<std::uint32_t>(text[i] - '0');
-            ++i;
+constexpr std::uint64_t pow10_19 = 10000000000000000000ULL;
+
+// splitmix64 の最終段。
+constexpr std::uint64_t mix64(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// 上位の語を攪拌してから下位の語と合わせ、もう一度攪拌する。
+constexpr std::uint64_t hash_words(std::uint64_t high, std::uint64_t low) {
+    return mix64(low ^ mix64(high + 0x9e3779b97f4a7c15ULL));
+}
+
+constexpr bool is_digit(char c) { return '0' <= c && c <= '9'; }
+
+constexpr bool is_space(char c) { return c == ' ' || ('\t' <= c && c <= '\r'); }
+
+constexpr std::array<char, 200> make_digit_pairs() {
+    std::array<char, 200> pairs{};
+    for (int i = 0; i < 100; ++i) {
+        pairs[2 * i] = static_cast<char>('0' + i / 10);
+        pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}
+
+inline constexpr std::array<char, 200> digit_pairs = make_digit_pairs();
+
+inline std::uint64_t load_8_chars(const char *first) {
+    std::uint64_t chunk;
+    std::memcpy(&chunk, first, 8);
+    return chunk;
+}
+
+// [first, first + 8) がすべて数字であるかを判定する。
+inline bool are_8_digits(const char *first) {
+    if constexpr (std::endian::native == std::endian::little) {
+        constexpr std::uint64_t high_nibbles = 0xf0f0f0f0f0f0f0f0ULL;
+        constexpr std::uint64_t zeros = 0x3030303030303030ULL;
+        const std::uint64_t chunk = load_8_chars(first);
+        return (chunk & high_nibbles) == zeros &&
+               ((chunk + 0x0606060606060606ULL) & high_nibbles) == zeros;
+    } else {
+        for (int i = 0; i < 8; ++i) {
+            if (!is_digit(first[i])) {
+                return false;
+            }
         }
-        value = UInt128(chunk);
+        return true;
     }
+}
 
-    while (i < text.size()) {
-        std::uint32_t chunk = 0;
-        for (int j = 0; j < 9; ++j) {
-            assert('0' <= text[i] && text[i] <= '9');
-            chunk = chunk * 10 + static_cast<std::uint32_t>(text[i] - '0');
-            ++i;
+// [first, first + 8) がすべて数字であることを仮定する。
+inline std::uint64_t parse_8_digits(const char *first) {
+    if constexpr (std::endian::native == std::endian::little) {
+        // 各バイトの数字を、隣り合う 2 桁、4 桁、8 桁の順にまとめる。
+        std::uint64_t chunk = load_8_chars(first) - 0x3030303030303030ULL;
+        chunk = (chunk * 10 + (chunk >> 8)) & 0x00ff00ff00ff00ffULL;
+        chunk = (chunk * 100 + (chunk >> 16)) & 0x0000ffff0000ffffULL;
+        return (chunk * 10000 + (chunk >> 32)) & 0xffffffffULL;
+    } else {
+        std::uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value = value * 10 + static_cast<std::uint64_t>(first[i] - '0');
         }
-        value *= UInt128(1000000000);
-        value += UInt128(chunk);
+        return value;
     }
+}
+
+// first から続く数字の直後を返す。
+inline const char *skip_digits(const char *first, const char *last) {
+    while (last - first >= 8 && are_8_digits(first)) {
+        first += 8;
+    }
+    while (first != last && is_digit(*first)) {
+        ++first;
+    }
+    return first;
+}
 
+// [first, first + count) がすべて数字であり、count <= 19 であることを仮定する。
+inline std::uint64_t parse_digits(const char *first, std::ptrdiff_t count) {
+    std::uint64_t value = 0;
+    for (; count >= 8; count -= 8) {
+        value = value * 100000000 + parse_8_digits(first);
+        first += 8;
+    }
+    for (; count > 0; --count) {
+        value = value * 10 + static_cast<std::uint64_t>(*first - '0');
+        ++first;
+    }
     return value;
 }
 
-inline void write_padded_9(std::ostream &output, std::uint32_t value) {
-    char buffer[9];
-    for (int i = 8; i >= 0; --i) {
-        buffer[i] = static_cast<char>('0' + value % 10);
-        value /= 10;
+// [first, last) がすべて数字であることを仮定する。
+// 表す値が UInt128 の範囲に収まらない場合は false を返す。
+inline bool parse_uint128_digits(const char *first, const char *last,
+                                 UInt128 &value) {
+    while (first != last && *first == '0') {
+        ++first;
+    }
+    const std::ptrdiff_t count = last - first;
+    if (count <= 19) {
+        value = UInt128(parse_digits(first, count));
+        return true;
+    }
+    if (count > 39) {
+        return false;
+    }
+
+    // 末尾の 38 桁以内を上位 19 桁と下位 19 桁に分けて読む。
+    std::uint64_t top = 0;
+    if (count == 39) {
+        top = static_cast<std::uint64_t>(*first - '0');
+        ++first;
     }
-    output.write(buffer, 9);
+    const std::uint64_t high = parse_digits(first, last - first - 19);
+    const std::uint64_t low = parse_digits(last - 19, 19);
+    const UInt128 rest = UInt128::multiply_u64(high, pow10_19) + UInt128(low);
+    if (top == 0) {
+        value = rest;
+        return true;
+    }
+
+    // 2^128 < 4 10^38
+    if (top > 3) {
+        return false;
+    }
+    const UInt128 head =
+        UInt128(top) * UInt128::multiply_u64(pow10_19, pow10_19);
+    value = head + rest;
+    return value >= head;
 }
 
-inline void write_uint128_decimal(std::ostream &output, UInt128 value) {
-    if (value == UInt128(0)) {
-        output << '0';
-        return;
+// value の 10 進法表記を end の直前から書き込み、書き込んだ先頭を返す。
+inline char *write_digits_backward(char *end, std::uint64_t value) {
+    while (value >= 100) {
+        end -= 2;
+        std::memcpy(end, &digit_pairs[2 * (value % 100)], 2);
+        value /= 100;
+    }
+    if (value >= 10) {
+        end -= 2;
+        std::memcpy(end, &digit_pairs[2 * value], 2);
+    } else {
+        *--end = static_cast<char>('0' + value);
+    }
+    return end;
+}
+
+// value を 0 埋めした 19 桁の 10 進法表記で end の直前から書き込む。
+// value < 10^19 を仮定する。
+inline char *write_padded_19_backward(char *end, std::uint64_t value) {
+    for (int i = 0; i < 9; ++i) {
+        end -= 2;
+        std::memcpy(end, &digit_pairs[2 * (value % 100)], 2);
+        value /= 100;
     }
+    *--end = static_cast<char>('0' + value);
+    return end;
+}
 
-    constexpr std::uint32_t base = 1000000000;
-    std::uint32_t parts[5] = {};
-    int size = 0;
-    while (value != UInt128(0)) {
+// value の 10 進法表記を end の直前から書き込み、書き込んだ先頭を返す。
+// end の直前に 39 文字分の領域があることを仮定する。
+inline char *write_uint128_backward(char *end, UInt128 value) {
+    const UInt128 base = UInt128(pow10_19);
+    while (value.high() != 0 || value.low() >= pow10_19) {
         UInt128 quotient;
         UInt128 remainder;
-        UInt128::div_mod(value, UInt128(base), quotient, remainder);
-        parts[size] = static_cast<std::uint32_t>(remainder);
+        UInt128::div_mod(value, base, quotient, remainder);
+        end = write_padded_19_backward(end, remainder.low());
         value = quotient;
-        ++size;
     }
+    return write_digits_backward(end, value.low());
+}
 
-    output << parts[size - 1];
-    for (int i = size - 2; i >= 0; --i) {
-        write_padded_9(output, parts[i]);
+inline std::to_chars_result copy_chars(char *first, char *last,
+                                       const char *source_first,
+                                       const char *source_last) {
+    const std::ptrdiff_t size = source_last - source_first;
+    if (last - first < size) {
+        return {last, std::errc::value_too_large};
     }
+    std::memcpy(first, source_first, static_cast<std::size_t>(size));
+    return {first + size, std::errc{}};
 }
-} // namespace int128_internal
 
-inline std::istream &operator>>(std::istream &input, UInt128 &value) {
+// 符号 '+' を 1 つまで許し、トークン全体を 10 進法表記として読む。
+template <class T> void read_decimal(std::istream &input, T &value) {
     std::string text;
     input >> text;
     if (!input) {
-        return input;
+        return;
     }
 
-    std::size_t first = 0;
-    if (text[first] == '+') {
+    const char *first = text.data();
+    const char *last = first + text.size();
+    if (*first == '+' && last - first >= 2 && first[1] != '-') {
         ++first;
     }
-    assert(first < text.size());
-    assert(text[first] != '-');
+    T parsed;
+    const std::from_chars_result result = from_chars(first, last, parsed);
+    if (result.ec != std::errc{} || result.ptr != last) {
+        input.setstate(std::ios_base::failbit);
+        return;
+    }
+    value = parsed;
+}
 
-    value = int128_internal::read_uint128_decimal(text, first);
-    return input;
+template <class T>
+std::from_chars_result parse_sequence(const char *first, const char *last,
+                                      std::vector<T> &values) {
+    while (true) {
+        while (first != last && is_space(*first)) {
+            ++first;
+        }
+        if (first == last) {
+            return {last, std::errc{}};
+        }
+
+        T value;
+        const std::from_chars_result result = from_chars(first, last, value);
+        if (result.ec != std::errc{}) {
+            return result;
+        }
+        if (result.ptr != last && !is_space(*result.ptr)) {
+            return {result.ptr, std::errc::invalid_argument};
+        }
+        values.push_back(value);
+        first = result.ptr;
+    }
 }
+} // namespace int128_internal
 
-inline std::ostream &operator<<(std::ostream &output, UInt128 value) {
-    int128_internal::write_uint128_decimal(output, value);
-    return output;
+inline std::from_chars_result from_chars(const char *first, const char *last,
+                                         UInt128 &value) {
+    const char *digits_last = int128_internal::skip_digits(first, last);
+    if (digits_last == first) {
+        return {first, std::errc::invalid_argument};
+    }
+    UInt128 parsed;
+    if (!int128_internal::parse_uint128_digits(first, digits_last, parsed)) {
+        return {digits_last, std::errc::result_out_of_range};
+    }
+    value = parsed;
+    return {digits_last, std::errc{}};
 }
 
-inline std::istream &operator>>(std::istream &input, Int128 &value) {
-    std::string text;
-    input >> text;
-    if (!input) {
-        return input;
+inline std::from_chars_result from_chars(const char *first, const char *last,
+                                         Int128 &value) {
+    const bool negative = first != last && *first == '-';
+    const char *digits_first = negative ? first + 1 : first;
+    const char *digits_last = int128_internal::skip_digits(digits_first, last);
+    if (digits_last == digits_first) {
+        return {first, std::errc::invalid_argument};
+    }
+    UInt128 magnitude;
+    if (!int128_internal::parse_uint128_digits(digits_first, digits_last,
+                                               magnitude)) {
+        return {digits_last, std::errc::result_out_of_range};
+    }
+    const UInt128 limit = UInt128::from_words(std::uint64_t{1} << 63, 0);
+    if (negative ? magnitude > limit : magnitude >= limit) {
+        return {digits_last, std::errc::result_out_of_range};
     }
+    value = Int128::from_unsigned(magnitude, negative);
+    return {digits_last, std::errc{}};
+}
 
-    std::size_t first = 0;
-    bool negative = false;
-    if (text[first] == '+' || text[first] == '-') {
-        negative = text[first] == '-';
-        ++first;
+inline std::to_chars_result to_chars(char *first, char *last, UInt128 value) {
+    char buffer[39];
+    char *const end = buffer + 39;
+    return int128_internal::copy_chars(
+        first, last, int128_internal::write_uint128_backward(end, value), end);
+}
+
+inline std::to_chars_result to_chars(char *first, char *last, Int128 value) {
+    char buffer[40];
+    char *const end = buffer + 40;
+    char *begin = int128_internal::write_uint128_backward(
+        end, Int128::abs_unsigned(value));
+    if (value.is_negative()) {
+        *--begin = '-';
     }
-    assert(first < text.size());
+    return int128_internal::copy_chars(first, last, begin, end);
+}
 
-    const UInt128 magnitude =
-        int128_internal::read_uint128_decimal(text, first);
-    value = Int128::from_unsigned(magnitude, negative);
+// [first, last) に空白区切りで並んだ 10 進法表記の整数を読み、values の末尾に追加する。
+// すべて読めた場合は {last, std::errc{}} を返す。
+// 読めない箇所があった場合は、その位置とエラーを返す。それまでに読んだ値は追加されている。
+inline std::from_chars_result
+parse_uint128_sequence(const char *first, const char *last,
+                       std::vector<UInt128> &values) {
+    return int128_internal::parse_sequence(first, last, values);
+}
+
+inline std::from_chars_result
+parse_int128_sequence(const char *first, const char *last,
+                      std::vector<Int128> &values) {
+    return int128_internal::parse_sequence(first, last, values);
+}
+
+inline std::istream &operator>>(std::istream &input, UInt128 &value) {
+    int128_internal::read_decimal(input, value);
+    return input;
+}
+
+inline std::ostream &operator<<(std::ostream &output, UInt128 value) {
+    char buffer[39];
+    const std::to_chars_result result = to_chars(buffer, buffer + 39, value);
+    output.write(buffer, result.ptr - buffer);
+    return output;
+}
+
+inline std::istream &operator>>(std::istream &input, Int128 &value) {
+    int128_internal::read_decimal(input, value);
     return input;
 }
 
 inline std::ostream &operator<<(std::ostream &output, Int128 value) {
-    if (value.is_negative()) {
-        output << '-';
-        int128_internal::write_uint128_decimal(output,
-                                               Int128::abs_unsigned(value));
-    } else {
-        int128_internal::write_uint128_decimal(
-            output, UInt128::from_words(value.high(), value.low()));
-    }
+    char buffer[40];
+    const std::to_chars_result result = to_chars(buffer, buffer + 40, value);
+    output.write(buffer, result.ptr - buffer);
     return output;
 }
 } // namespace NicheLibrary
@@ -821,6 +1082,20 @@ template <> class numeric_limits<NicheLibrary::Int128> {
     static constexpr bool tinyness_before = false;
     static constexpr float_round_style round_style = round_toward_zero;
 };
+
+template <> struct hash<NicheLibrary::UInt128> {
+    size_t operator()(NicheLibrary::UInt128 value) const noexcept {
+        return static_cast<size_t>(NicheLibrary::int128_internal::hash_words(
+            value.high(), value.low()));
+    }
+};
+
+template <> struct hash<NicheLibrary::Int128> {
+    size_t operator()(NicheLibrary::Int128 value) const noexcept {
+        return static_cast<size_t>(NicheLibrary::int128_internal::hash_words(
+            value.high(), value.low()));
+    }
+};
 } // namespace std
 
 #endif
@@ -0,0 +1,166 @@
+#ifndef INTERNAL_UINT_ONE_TWO_EIGHT_BATCH_HPP
+#define INTERNAL_UINT_ONE_TWO_EIGHT_BATCH_HPP
+
+// UInt128 の列を上位 64 bit の配列と下位 64 bit の配列に分けて保持し（structure of arrays）、
+// 要素ごとの加算、減算、下位 128 bit の乗算、比較と、累積和をまとめて行う。
+// 加算、減算、比較は分岐のない 64 bit 演算のみからなり、処理系による自動ベクトル化を想定している。
+// 繰り上がりは比較の結果から求める。
+// 各関数の計算量は要素数を n として O(n)。
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "int128.hpp"
+
+namespace NicheLibrary {
+struct ConstUInt128Span {
+    const std::uint64_t *high = nullptr;
+    const std::uint64_t *low = nullptr;
+    std::size_t size = 0;
+
+    UInt128 operator[](std::size_t index) const {
+        return UInt128::from_words(high[index], low[index]);
+    }
+};
+
+struct UInt128Span {
+    std::uint64_t *high = nullptr;
+    std::uint64_t *low = nullptr;
+    std::size_t size = 0;
+
+    UInt128 operator[](std::size_t index) const {
+        return UInt128::from_words(high[index], low[index]);
+    }
+
+    void set(std::size_t index, UInt128 value) const {
+        high[index] = value.high();
+        low[index] = value.low();
+    }
+
+    operator ConstUInt128Span() const { return {high, low, size}; }
+};
+
+// 上位 64 bit と下位 64 bit を別々の配列で持つ UInt128 の列。
+class UInt128Array {
+  public:
+    UInt128Array() = default;
+
+    explicit UInt128Array(std::size_t size) : high_(size), low_(size) {}
+
+    explicit UInt128Array(const std::vector<UInt128> &values)
+        : high_(values.size()), low_(values.size()) {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            high_[i] = values[i].high();
+            low_[i] = values[i].low();
+        }
+    }
+
+    std::size_t size() const { return low_.size(); }
+
+    UInt128 operator[](std::size_t index) const {
+        return UInt128::from_words(high_[index], low_[index]);
+    }
+
+    void set(std::size_t index, UInt128 value) {
+        high_[index] = value.high();
+        low_[index] = value.low();
+    }
+
+    UInt128Span span() { return {high_.data(), low_.data(), size()}; }
+
+    ConstUInt128Span span() const {
+        return {high_.data(), low_.data(), size()};
+    }
+
+    std::vector<UInt128> to_vector() const {
+        std::vector<UInt128> values(size());
+        for (std::size_t i = 0; i < size(); ++i) {
+            values[i] = (*this)[i];
+        }
+        return values;
+    }
+
+  private:
+    std::vector<std::uint64_t> high_;
+    std::vector<std::uint64_t> low_;
+};
+
+// out[i] = lhs[i] + rhs[i] (mod 2^128)。out は lhs や rhs と同じ領域でもよい。
+inline void uint128_batch_add(ConstUInt128Span lhs, ConstUInt128Span rhs,
+                              UInt128Span out) {
+    assert(lhs.size == out.size && rhs.size == out.size);
+    for (std::size_t i = 0; i < out.size; ++i) {
+        const std::uint64_t low = lhs.low[i] + rhs.low[i];
+        const std::uint64_t carry = low < lhs.low[i] ? 1 : 0;
+        out.high[i] = lhs.high[i] + rhs.high[i] + carry;
+        out.low[i] = low;
+    }
+}
+
+// out[i] = lhs[i] - rhs[i] (mod 2^128)。out は lhs や rhs と同じ領域でもよい。
+inline void uint128_batch_sub(ConstUInt128Span lhs, ConstUInt128Span rhs,
+                              UInt128Span out) {
+    assert(lhs.size == out.size && rhs.size == out.size);
+    for (std::size_t i = 0; i < out.size; ++i) {
+        const std::uint64_t borrow = lhs.low[i] < rhs.low[i] ? 1 : 0;
+        out.high[i] = lhs.high[i] - rhs.high[i] - borrow;
+        out.low[i] = lhs.low[i] - rhs.low[i];
+    }
+}
+
+// out[i] = lhs[i] rhs[i] (mod 2^128)。out は lhs や rhs と同じ領域でもよい。
+inline void uint128_batch_mul_low(ConstUInt128Span lhs, ConstUInt128Span rhs,
+                                  UInt128Span out) {
+    assert(lhs.size == out.size && rhs.size == out.size);
+    for (std::size_t i = 0; i < out.size; ++i) {
+        const UInt128 product = UInt128::multiply_u64(lhs.low[i], rhs.low[i]);
+        out.high[i] = product.high() + lhs.low[i] * rhs.high[i] +
+                      lhs.high[i] * rhs.low[i];
+        out.low[i] = product.low();
+    }
+}
+
+// out[i] = (lhs[i] < rhs[i])。
+inline void uint128_batch_less(ConstUInt128Span lhs, ConstUInt128Span rhs,
+                               bool *out) {
+    assert(lhs.size == rhs.size);
+    for (std::size_t i = 0; i < lhs.size; ++i) {
+        const bool high_less = lhs.high[i] < rhs.high[i];
+        const bool high_equal = lhs.high[i] == rhs.high[i];
+        const bool low_less = lhs.low[i] < rhs.low[i];
+        out[i] = high_less | (high_equal & low_less);
+    }
+}
+
+// values を累積和 values[0] + ... + values[i] (mod 2^128) で置き換える。
+inline void uint128_batch_prefix_sum(UInt128Span values) {
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+    for (std::size_t i = 0; i < values.size; ++i) {
+        const std::uint64_t next_low = low + values.low[i];
+        high += values.high[i] + (next_low < low ? 1 : 0);
+        low = next_low;
+        values.high[i] = high;
+        values.low[i] = low;
+    }
+}
+
+// values の総和 (mod 2^128) を返す。
+inline UInt128 uint128_batch_sum(ConstUInt128Span values) {
+    // 下位の語の繰り上がりを数えておき、最後に上位の語へまとめて足す。
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+    std::uint64_t carries = 0;
+    for (std::size_t i = 0; i < values.size; ++i) {
+        const std::uint64_t next_low = low + values.low[i];
+        carries += next_low < low ? 1 : 0;
+        high += values.high[i];
+        low = next_low;
+    }
+    return UInt128::from_words(high + carries, low);
+}
+} // namespace NicheLibrary
+
+#endif
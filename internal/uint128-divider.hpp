@@ -0,0 +1,224 @@
+#ifndef INTERNAL_UINT_ONE_TWO_EIGHT_DIVIDER_HPP
+#define INTERNAL_UINT_ONE_TWO_EIGHT_DIVIDER_HPP
+
+// 同じ除数による UInt128 の除算を繰り返すために、除数の逆数を前計算する。
+// Möller–Granlund の方法により、除算 1 回あたり定数回の 64 bit 乗算で商と余りを求める。
+// 除数は 0 でないことを仮定する。
+// 256 bit の値の剰余と、剰余乗算も同様に求める。
+// 構築時に UInt128 の除算を 1 回行い、以降の除算は除数によらず定数時間。
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+#include "int128.hpp"
+
+namespace NicheLibrary {
+namespace uint128_divider_internal {
+// 最上位 bit が立った d に対し、floor((2^128 - 1) / d) - 2^64 を返す。
+constexpr std::uint64_t reciprocal_2by1(std::uint64_t d) {
+    return (UInt128::from_words(~d, ~std::uint64_t{}) / UInt128(d)).low();
+}
+
+// 最上位 bit が立った d1 と任意の d0 に対し、
+// floor((2^192 - 1) / (d1 2^64 + d0)) - 2^64 を返す。
+constexpr std::uint64_t reciprocal_3by2(std::uint64_t d1, std::uint64_t d0) {
+    std::uint64_t v = reciprocal_2by1(d1);
+    std::uint64_t p = d1 * v + d0;
+    if (p < d0) {
+        --v;
+        if (p >= d1) {
+            --v;
+            p -= d1;
+        }
+        p -= d1;
+    }
+    const UInt128 t = UInt128::multiply_u64(v, d0);
+    p += t.high();
+    if (p < t.high()) {
+        --v;
+        if (UInt128::from_words(p, t.low()) >= UInt128::from_words(d1, d0)) {
+            --v;
+        }
+    }
+    return v;
+}
+
+// u1 < d と d の最上位 bit が立っていることを仮定する。
+constexpr std::uint64_t div_2by1(std::uint64_t u1, std::uint64_t u0,
+                                 std::uint64_t d, std::uint64_t v,
+                                 std::uint64_t &remainder) {
+    const UInt128 q =
+        UInt128::multiply_u64(v, u1) + UInt128::from_words(u1, u0);
+    std::uint64_t q1 = q.high() + 1;
+    std::uint64_t r = u0 - q1 * d;
+    if (r > q.low()) {
+        --q1;
+        r += d;
+    }
+    if (r >= d) {
+        ++q1;
+        r -= d;
+    }
+    remainder = r;
+    return q1;
+}
+
+// (u2, u1) < (d1, d0) と d1 の最上位 bit が立っていることを仮定する。
+constexpr std::uint64_t div_3by2(std::uint64_t u2, std::uint64_t u1,
+                                 std::uint64_t u0, UInt128 d, std::uint64_t v,
+                                 UInt128 &remainder) {
+    const UInt128 q =
+        UInt128::multiply_u64(v, u2) + UInt128::from_words(u2, u1);
+    std::uint64_t q1 = q.high();
+    UInt128 r = UInt128::from_words(u1 - q1 * d.high(), u0) -
+                UInt128::multiply_u64(d.low(), q1) - d;
+    ++q1;
+    if (r.high() >= q.low()) {
+        --q1;
+        r += d;
+    }
+    if (r >= d) {
+        ++q1;
+        r -= d;
+    }
+    remainder = r;
+    return q1;
+}
+
+// lhs rhs を 2^128 で割った商を high に、余りを low に書き込む。
+constexpr void multiply_wide(UInt128 lhs, UInt128 rhs, UInt128 &high,
+                             UInt128 &low) {
+    const UInt128 ll = UInt128::multiply_u64(lhs.low(), rhs.low());
+    const UInt128 lh = UInt128::multiply_u64(lhs.low(), rhs.high());
+    const UInt128 hl = UInt128::multiply_u64(lhs.high(), rhs.low());
+    const UInt128 hh = UInt128::multiply_u64(lhs.high(), rhs.high());
+    const UInt128 middle =
+        UInt128(ll.high()) + UInt128(lh.low()) + UInt128(hl.low());
+    low = UInt128::from_words(middle.low(), ll.low());
+    high = hh + UInt128(lh.high()) + UInt128(hl.high()) +
+           UInt128(middle.high());
+}
+
+// 0 <= shift < 64 を仮定する。
+constexpr UInt128 shift_right(UInt128 value, int shift) {
+    if (shift == 0) {
+        return value;
+    }
+    return UInt128::from_words(value.high() >> shift,
+                               (value.low() >> shift) |
+                                   (value.high() << (64 - shift)));
+}
+} // namespace uint128_divider_internal
+
+class UInt128Divider {
+  public:
+    explicit constexpr UInt128Divider(UInt128 divisor) : divisor_(divisor) {
+        assert(divisor != UInt128{});
+        namespace div_internal = uint128_divider_internal;
+        if (divisor.high() == 0) {
+            shift_ = std::countl_zero(divisor.low());
+            normalized_ = UInt128(divisor.low() << shift_);
+            reciprocal_ = div_internal::reciprocal_2by1(normalized_.low());
+        } else {
+            shift_ = std::countl_zero(divisor.high());
+            normalized_ = UInt128::from_words(
+                (divisor.high() << shift_) |
+                    (shift_ == 0 ? 0 : divisor.low() >> (64 - shift_)),
+                divisor.low() << shift_);
+            reciprocal_ = div_internal::reciprocal_3by2(normalized_.high(),
+                                                        normalized_.low());
+        }
+    }
+
+    constexpr UInt128 divisor() const { return divisor_; }
+
+    constexpr void div_mod(UInt128 lhs, UInt128 &quotient,
+                           UInt128 &remainder) const {
+        namespace div_internal = uint128_divider_internal;
+        const std::uint64_t u2 = shift_ == 0 ? 0 : lhs.high() >> (64 - shift_);
+        const std::uint64_t u1 =
+            (lhs.high() << shift_) |
+            (shift_ == 0 ? 0 : lhs.low() >> (64 - shift_));
+        const std::uint64_t u0 = lhs.low() << shift_;
+
+        if (normalized_.high() == 0) {
+            const std::uint64_t d = normalized_.low();
+            std::uint64_t q1 = 0;
+            std::uint64_t r = u1;
+            if (u2 != 0 || u1 >= d) {
+                q1 = div_internal::div_2by1(u2, u1, d, reciprocal_, r);
+            }
+            const std::uint64_t q0 =
+                div_internal::div_2by1(r, u0, d, reciprocal_, r);
+            quotient = UInt128::from_words(q1, q0);
+            remainder = UInt128(r >> shift_);
+            return;
+        }
+
+        UInt128 r;
+        const std::uint64_t q =
+            div_internal::div_3by2(u2, u1, u0, normalized_, reciprocal_, r);
+        quotient = UInt128(q);
+        remainder = div_internal::shift_right(r, shift_);
+    }
+
+    constexpr UInt128 quotient(UInt128 lhs) const {
+        UInt128 q;
+        UInt128 r;
+        div_mod(lhs, q, r);
+        return q;
+    }
+
+    constexpr UInt128 remainder(UInt128 lhs) const {
+        UInt128 q;
+        UInt128 r;
+        div_mod(lhs, q, r);
+        return r;
+    }
+
+    // high 2^128 + low を除数で割った余りを返す。high < divisor を仮定する。
+    constexpr UInt128 remainder_wide(UInt128 high, UInt128 low) const {
+        namespace div_internal = uint128_divider_internal;
+        assert(high < divisor_);
+        const auto shift_in = [this](std::uint64_t upper, std::uint64_t lower) {
+            return shift_ == 0 ? upper
+                               : (upper << shift_) | (lower >> (64 - shift_));
+        };
+        if (normalized_.high() == 0) {
+            // high < divisor < 2^64 より、high は 1 語に収まる。
+            const std::uint64_t d = normalized_.low();
+            std::uint64_t r = shift_in(high.low(), low.high());
+            div_internal::div_2by1(r, shift_in(low.high(), low.low()), d,
+                                   reciprocal_, r);
+            div_internal::div_2by1(r, low.low() << shift_, d, reciprocal_, r);
+            return UInt128(r >> shift_);
+        }
+
+        UInt128 r;
+        div_internal::div_3by2(shift_in(high.high(), high.low()),
+                               shift_in(high.low(), low.high()),
+                               shift_in(low.high(), low.low()), normalized_,
+                               reciprocal_, r);
+        div_internal::div_3by2(r.high(), r.low(), low.low() << shift_,
+                               normalized_, reciprocal_, r);
+        return div_internal::shift_right(r, shift_);
+    }
+
+    // lhs rhs を除数で割った余りを返す。lhs < divisor または rhs < divisor を仮定する。
+    constexpr UInt128 multiply_mod(UInt128 lhs, UInt128 rhs) const {
+        UInt128 high;
+        UInt128 low;
+        uint128_divider_internal::multiply_wide(lhs, rhs, high, low);
+        return remainder_wide(high, low);
+    }
+
+  private:
+    UInt128 divisor_;
+    UInt128 normalized_;
+    std::uint64_t reciprocal_ = 0;
+    int shift_ = 0;
+};
+} // namespace NicheLibrary
+
+#endif
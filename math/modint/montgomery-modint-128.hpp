@@ -0,0 +1,266 @@
+#ifndef MATH_MODINT_MONTGOMERY_MODINT_ONE_TWO_EIGHT_HPP
+#define MATH_MODINT_MONTGOMERY_MODINT_ONE_TWO_EIGHT_HPP
+
+// 2^128 未満の奇数 m を法とする剰余環の元を Montgomery 表現で扱う。
+// 乗算は 64 bit 乗算 8 回と UInt128 の乗算 1 回で行い、128 bit の除算を行わない。
+// 法はコンパイル時に指定する StaticMontgomeryModInt128 と、
+// 実行時に set_mod で指定する DynamicMontgomeryModInt128 がある。
+// 加算、減算、乗算は定数時間、pow は O(log e)、inv は O(log m)。
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#include "../../internal/int128.hpp"
+
+namespace montgomery_modint_128_internal {
+using NicheLibrary::UInt128;
+
+// a b = high 2^128 + low となる (high, low) を求める。
+constexpr void multiply_full(UInt128 a, UInt128 b, UInt128 &high,
+                             UInt128 &low) {
+    const UInt128 p00 = UInt128::multiply_u64(a.low(), b.low());
+    const UInt128 p01 = UInt128::multiply_u64(a.low(), b.high());
+    const UInt128 p10 = UInt128::multiply_u64(a.high(), b.low());
+    const UInt128 p11 = UInt128::multiply_u64(a.high(), b.high());
+    const UInt128 middle =
+        UInt128(p00.high()) + UInt128(p01.low()) + UInt128(p10.low());
+    low = UInt128::from_words(middle.low(), p00.low());
+    high = p11 + UInt128(p01.high()) + UInt128(p10.high()) +
+           UInt128(middle.high());
+}
+
+class MontgomeryContext {
+  public:
+    // mod は奇数であることを仮定する。
+    explicit constexpr MontgomeryContext(UInt128 mod)
+        : mod_(mod), mod_inv_(mod), r2_(0) {
+        // mod mod ≡ 1 (mod 8) から始め、Newton 法で 2^128 を法とする逆元を求める。
+        for (int i = 0; i < 6; ++i) {
+            mod_inv_ *= UInt128(2) - mod_ * mod_inv_;
+        }
+        // 2^128 mod mod から 128 回 2 倍して 2^256 mod mod を求める。
+        r2_ = -mod_ % mod_;
+        for (int i = 0; i < 128; ++i) {
+            r2_ = add(r2_, r2_);
+        }
+    }
+
+    constexpr UInt128 mod() const { return mod_; }
+
+    constexpr UInt128 r2() const { return r2_; }
+
+    // 0 <= a, b < mod を仮定する。
+    constexpr UInt128 add(UInt128 a, UInt128 b) const {
+        const UInt128 sum = a + b;
+        if (sum < a || sum >= mod_) {
+            return sum - mod_;
+        }
+        return sum;
+    }
+
+    // 0 <= a, b < mod を仮定する。
+    constexpr UInt128 sub(UInt128 a, UInt128 b) const {
+        if (a < b) {
+            return a - b + mod_;
+        }
+        return a - b;
+    }
+
+    // high 2^128 + low に 2^{-128} を掛けた値を mod で割った余りを返す。
+    // high < mod を仮定する。
+    constexpr UInt128 reduce(UInt128 high, UInt128 low) const {
+        UInt128 product_high;
+        UInt128 product_low;
+        multiply_full(low * mod_inv_, mod_, product_high, product_low);
+        if (high < product_high) {
+            return high - product_high + mod_;
+        }
+        return high - product_high;
+    }
+
+    // 0 <= a, b < mod を仮定する。
+    constexpr UInt128 multiply(UInt128 a, UInt128 b) const {
+        UInt128 high;
+        UInt128 low;
+        multiply_full(a, b, high, low);
+        return reduce(high, low);
+    }
+
+  private:
+    UInt128 mod_;
+    UInt128 mod_inv_;
+    UInt128 r2_;
+};
+
+template <std::uint64_t ModHigh, std::uint64_t ModLow> struct StaticModulus {
+    static_assert(ModLow % 2 == 1, "modulus must be odd.");
+
+    static constexpr MontgomeryContext context_ =
+        MontgomeryContext(UInt128::from_words(ModHigh, ModLow));
+
+    static constexpr const MontgomeryContext &context() { return context_; }
+};
+
+template <int Id> struct DynamicModulus {
+    static inline MontgomeryContext context_ = MontgomeryContext(UInt128(1));
+
+    static const MontgomeryContext &context() { return context_; }
+
+    static void set_mod(UInt128 mod) {
+        assert(mod.low() % 2 == 1);
+        context_ = MontgomeryContext(mod);
+    }
+};
+} // namespace montgomery_modint_128_internal
+
+template <class Modulus> class MontgomeryModInt128 {
+  public:
+    using UInt128 = NicheLibrary::UInt128;
+    using Int128 = NicheLibrary::Int128;
+
+    constexpr MontgomeryModInt128() = default;
+
+    template <class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    constexpr MontgomeryModInt128(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            *this = MontgomeryModInt128(Int128(value));
+        } else {
+            *this = MontgomeryModInt128(UInt128(value));
+        }
+    }
+
+    constexpr MontgomeryModInt128(UInt128 value)
+        : value_(context().multiply(value % mod(), context().r2())) {}
+
+    constexpr MontgomeryModInt128(Int128 value) {
+        const UInt128 bits = UInt128::from_words(value.high(), value.low());
+        if (value.is_negative()) {
+            *this = -MontgomeryModInt128(-bits);
+        } else {
+            *this = MontgomeryModInt128(bits);
+        }
+    }
+
+    static constexpr UInt128 mod() { return context().mod(); }
+
+    // 法を mod に変更する。DynamicMontgomeryModInt128 でのみ使用できる。
+    // mod は奇数であることを仮定する。
+    static void set_mod(UInt128 mod) { Modulus::set_mod(mod); }
+
+    constexpr UInt128 val() const {
+        return context().reduce(UInt128{}, value_);
+    }
+
+    constexpr MontgomeryModInt128 operator+() const { return *this; }
+
+    constexpr MontgomeryModInt128 operator-() const {
+        return from_montgomery(context().sub(UInt128{}, value_));
+    }
+
+    constexpr MontgomeryModInt128 &operator+=(MontgomeryModInt128 rhs) {
+        value_ = context().add(value_, rhs.value_);
+        return *this;
+    }
+
+    constexpr MontgomeryModInt128 &operator-=(MontgomeryModInt128 rhs) {
+        value_ = context().sub(value_, rhs.value_);
+        return *this;
+    }
+
+    constexpr MontgomeryModInt128 &operator*=(MontgomeryModInt128 rhs) {
+        value_ = context().multiply(value_, rhs.value_);
+        return *this;
+    }
+
+    constexpr MontgomeryModInt128 &operator/=(MontgomeryModInt128 rhs) {
+        return *this *= rhs.inv();
+    }
+
+    friend constexpr MontgomeryModInt128 operator+(MontgomeryModInt128 lhs,
+                                                   MontgomeryModInt128 rhs) {
+        return lhs += rhs;
+    }
+
+    friend constexpr MontgomeryModInt128 operator-(MontgomeryModInt128 lhs,
+                                                   MontgomeryModInt128 rhs) {
+        return lhs -= rhs;
+    }
+
+    friend constexpr MontgomeryModInt128 operator*(MontgomeryModInt128 lhs,
+                                                   MontgomeryModInt128 rhs) {
+        return lhs *= rhs;
+    }
+
+    friend constexpr MontgomeryModInt128 operator/(MontgomeryModInt128 lhs,
+                                                   MontgomeryModInt128 rhs) {
+        return lhs /= rhs;
+    }
+
+    friend constexpr bool operator==(MontgomeryModInt128 lhs,
+                                     MontgomeryModInt128 rhs) {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend constexpr bool operator!=(MontgomeryModInt128 lhs,
+                                     MontgomeryModInt128 rhs) {
+        return !(lhs == rhs);
+    }
+
+    constexpr MontgomeryModInt128 pow(UInt128 exponent) const {
+        MontgomeryModInt128 result = 1;
+        MontgomeryModInt128 base = *this;
+        while (exponent != UInt128{}) {
+            if (exponent.low() % 2 == 1) {
+                result *= base;
+            }
+            base *= base;
+            exponent /= UInt128(2);
+        }
+        return result;
+    }
+
+    // 値と法が互いに素であることを仮定する。
+    constexpr MontgomeryModInt128 inv() const {
+        UInt128 a = val();
+        UInt128 b = mod();
+        MontgomeryModInt128 x0 = 1;
+        MontgomeryModInt128 x1 = 0;
+        while (b != UInt128{}) {
+            UInt128 q;
+            UInt128 r;
+            UInt128::div_mod(a, b, q, r);
+            a = b;
+            b = r;
+            const MontgomeryModInt128 x2 = x0 - MontgomeryModInt128(q) * x1;
+            x0 = x1;
+            x1 = x2;
+        }
+        assert(a == UInt128(1) || mod() == UInt128(1));
+        return x0;
+    }
+
+  private:
+    static constexpr const montgomery_modint_128_internal::MontgomeryContext &
+    context() {
+        return Modulus::context();
+    }
+
+    static constexpr MontgomeryModInt128 from_montgomery(UInt128 value) {
+        MontgomeryModInt128 result;
+        result.value_ = value;
+        return result;
+    }
+
+    UInt128 value_;
+};
+
+template <std::uint64_t ModHigh, std::uint64_t ModLow>
+using StaticMontgomeryModInt128 = MontgomeryModInt128<
+    montgomery_modint_128_internal::StaticModulus<ModHigh, ModLow>>;
+
+template <int Id>
+using DynamicMontgomeryModInt128 =
+    MontgomeryModInt128<montgomery_modint_128_internal::DynamicModulus<Id>>;
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef MATH_MULTIPLICATIVE_FUNCTION_MULTIPLICATIVE_PREFIX_SUM_HPP
+#define MATH_MULTIPLICATIVE_FUNCTION_MULTIPLICATIVE_PREFIX_SUM_HPP
+
+// 素数 p での値が p を m で割った余りのみで定まる乗法的関数 f について、Σ_{n<=N} f(n) を求める。
+// f(p) = f_prime_by_residue[p mod m]、e >= 2 について f(p^e) = f_prime_power(p, e) とする。
+// 素数についての和は prime_counting_modulo の余りごとの表から求め、
+// 合成数についての和は Min_25 篩の後半を再帰せずに行う。
+// 素数を大きい順に見て、値 v の表を
+// R(v) += Σ_{e>=1, p^{e+1}<=v} f(p^e) (R(v / p^e) - F(p)) + f(p^{e+1})
+// で更新する。F(v) は v 以下の素数についての f の和であり、R の初期値でもある。
+// v / p^e < v のため、v の大きい順に更新すれば右辺の R は更新前の値になる。
+// T は加減乗算と long long からの変換を持つ型。N は非負、m は正を仮定する。
+// 計算量 O(φ(m) N^{3/4} / log N + m sqrt(N))、空間 O(φ(m) sqrt(N) + m)。
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "prime-counting-modulo.hpp"
+
+namespace multiplicative_prefix_sum_internal {
+// ns[i] 以下の n についての Σ_{n>=1} f(n) の表を返す。ns は prime_counting_modulo の表と同じ。
+template <class T, class PrimePower>
+std::pair<std::vector<long long>, std::vector<T>>
+make_table(long long N, long long m, const std::vector<T> &f_prime_by_residue,
+           PrimePower &f_prime_power, unsigned thread_count) {
+    using i64 = long long;
+    namespace pcm_internal = prime_counting_modulo_internal;
+    assert(static_cast<i64>(f_prime_by_residue.size()) == m);
+    pcm_internal::CoprimeTable table =
+        pcm_internal::make_coprime_table(N, m, thread_count);
+    const std::vector<i64> &ns = table.ns;
+    const i64 nsz = static_cast<i64>(ns.size());
+    const i64 k = table.width();
+    const i64 sq = pcm_internal::integer_sqrt(N);
+
+    // 値 w の添字。
+    const auto index = [&](i64 w) { return w <= sq ? nsz - w : N / w; };
+
+    // R の初期値 F(ns[i])。
+    std::vector<T> sums(nsz, T(0));
+    for (i64 i = 0; i < nsz; ++i) {
+        T sum(0);
+        for (i64 c = 0; c < k; ++c) {
+            sum = sum + f_prime_by_residue[table.residues[c]] *
+                            T(table.values[i * k + c]);
+        }
+        for (const i64 p : table.prime_divisors) {
+            if (p <= ns[i]) {
+                sum = sum + f_prime_by_residue[p % m];
+            }
+        }
+        sums[i] = sum;
+    }
+
+    std::vector<i64> primes;
+    std::vector<char> composite(sq + 1);
+    for (i64 p = 2; p <= sq; ++p) {
+        if (composite[p]) {
+            continue;
+        }
+        primes.push_back(p);
+        for (i64 j = p * p; j <= sq; j += p) {
+            composite[j] = 1;
+        }
+    }
+
+    // powers[e - 1] = f(p^e)
+    std::vector<T> powers;
+    for (auto it = primes.rbegin(); it != primes.rend(); ++it) {
+        const i64 p = *it;
+        const T prime_sum = sums[nsz - p];
+        powers.assign(1, f_prime_by_residue[p % m]);
+        for (i64 i = 1; i < nsz && ns[i] / p >= p; ++i) {
+            const i64 v = ns[i];
+            T add(0);
+            i64 e = 1;
+            for (i64 power = p; power <= v / p; power *= p, ++e) {
+                if (static_cast<i64>(powers.size()) <= e) {
+                    powers.push_back(f_prime_power(p, e + 1));
+                }
+                add = add + powers[e - 1] * (sums[index(v / power)] -
+                                             prime_sum) +
+                      powers[e];
+            }
+            sums[i] = sums[i] + add;
+        }
+    }
+    // f(1) を加える。
+    for (i64 i = 1; i < nsz; ++i) {
+        sums[i] = sums[i] + T(1);
+    }
+    return {std::move(table.ns), std::move(sums)};
+}
+} // namespace multiplicative_prefix_sum_internal
+
+// Σ_{1<=n<=N} f(n) を返す。f(1) = 1 とする。
+template <class T, class PrimePower>
+T multiplicative_prefix_sum(long long N, long long m,
+                            const std::vector<T> &f_prime_by_residue,
+                            PrimePower f_prime_power,
+                            unsigned thread_count = 1) {
+    assert(N >= 0);
+    assert(m > 0);
+    if (N == 0) {
+        return T(0);
+    }
+    const auto table = multiplicative_prefix_sum_internal::make_table(
+        N, m, f_prime_by_residue, f_prime_power, thread_count);
+    return table.second[1];
+}
+
+// first[i] 以下の n についての Σ_{n>=1} f(n) を second[i] とする表を返す。
+// first は prime_counting_modulo_table(N, m).first と同じ。
+template <class T, class PrimePower>
+std::pair<std::vector<long long>, std::vector<T>>
+multiplicative_prefix_sum_table(long long N, long long m,
+                                const std::vector<T> &f_prime_by_residue,
+                                PrimePower f_prime_power,
+                                unsigned thread_count = 1) {
+    assert(N >= 0);
+    assert(m > 0);
+    return multiplicative_prefix_sum_internal::make_table(
+        N, m, f_prime_by_residue, f_prime_power, thread_count);
+}
+
+#endif
@@ -4,11 +4,26 @@
 // N 以下の素数を、m で割った余りごとに数える。
 // Lucy DP のテーブルを余りごとに持ち、素数 x によるふるいを同時に行う。
 // N は非負、m は正を仮定する。
-// 戻り値のテーブルの 1 つ目の添字は m で割った余りである。
-// 計算量 O(m N^{3/4} / log N)、空間 O(m sqrt(N))。
+// テーブルは m と互いに素な φ(m) 個の余りの分のみを持ち、m の素因数は後から補正する。
+// テーブルは値ごとに φ(m) 個の余りを連続して並べた 1 つの配列で持つ。
+// thread_count を指定すると、各素数によるふるいを複数のスレッドで分担する。
+// thread_count が 0 の場合は std::thread::hardware_concurrency() を用いる。結果はスレッド数によらない。
+// prime_counting_modulo_table の戻り値のテーブルは、1 つ目の添字が m で割った余りになるよう並べ替える。
+// 計算量 O(φ(m) N^{3/4} / log N + m sqrt(N))、空間 O(m sqrt(N))。
+// prime_power_sum_modulo_table は、余りごとの素数の d 乗和 (0 <= d <= k) を T で求める。
+// 全ての次数を 1 つのテーブルで持ち、素数ごとのふるいを全ての次数で共有する。計算量は φ(m) を (k + 1) φ(m) に置き換えたもの。
+// prime_counting_modulo は、L 以下の値を bit 列と Fenwick tree で持つ方法も選べる。
+// 計算量 O((φ(m) N)^{2/3} log N + m sqrt(N) / log N)、空間 O((φ(m) N)^{2/3} + m)。
 
+#include <algorithm>
+#include <barrier>
+#include <bit>
 #include <cassert>
-#include <type_traits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -44,18 +59,340 @@ inline long long count_residue_2_to_n(long long n, long long m, long long r,
     return res;
 }
 
-inline void add_mod_nonzero(long long &x, long long a, long long m) {
-    if (x >= m - a) {
-        x -= m - a;
-    } else {
-        x += a;
+// m と互いに素な余りの一覧と、m の素因数。
+// m と互いに素でない素数 x の倍数は m と互いに素な余りを持たないため、
+// 互いに素な余りについての値は互いに素な素数によるふるいのみで定まる。
+// 互いに素でない余りに属する素数は m の素因数のみであり、後から補正する。
+struct ResidueClasses {
+    long long m = 1;
+    std::vector<long long> residues;
+    // residues での添字。m と互いに素でない余りでは -1。
+    std::vector<long long> class_index;
+    std::vector<long long> prime_divisors;
+
+    long long width() const { return static_cast<long long>(residues.size()); }
+};
+
+inline ResidueClasses make_residue_classes(long long m) {
+    ResidueClasses classes;
+    classes.m = m;
+    classes.class_index.assign(m, -1);
+    for (long long r = 0; r < m; ++r) {
+        long long a = m, b = r;
+        while (b != 0) {
+            a = std::exchange(b, a % b);
+        }
+        if (a == 1) {
+            classes.class_index[r] = classes.width();
+            classes.residues.push_back(r);
+        }
     }
+    long long rest = m;
+    for (long long p = 2; p <= rest / p; ++p) {
+        if (rest % p == 0) {
+            classes.prime_divisors.push_back(p);
+            while (rest % p == 0) {
+                rest /= p;
+            }
+        }
+    }
+    if (rest > 1) {
+        classes.prime_divisors.push_back(rest);
+    }
+    return classes;
 }
 
-inline std::pair<std::vector<long long>, std::vector<std::vector<long long>>>
-make_table(long long N, long long m) {
+// m と互いに素な x について、target[c] を residues[c] x mod m の添字とする。
+// target が恒等写像であれば true を返し、target は変更しない。
+inline bool make_target(const ResidueClasses &classes, long long x,
+                        std::vector<long long> &target) {
+    const long long m = classes.m;
+    const long long x_mod = x % m;
+    if (x_mod == 1 % m) {
+        return true;
+    }
+    for (long long r = 0, to = 0; r < m; ++r) {
+        if (classes.class_index[r] >= 0) {
+            target[classes.class_index[r]] = classes.class_index[to];
+        }
+        to += x_mod;
+        if (to >= m) {
+            to -= m;
+        }
+    }
+    return false;
+}
+
+// C(n, s) を T での除算を用いずに求める。n >= 0 を仮定する。
+// n (n - 1) ... (n - s + 1) の各項から 2, ..., s を gcd で順に取り除いてから掛ける。
+// d を取り除く時点で残りの積は s! / (d - 1)! の倍数であるため、d は必ず取り除ける。
+template <class T>
+T binomial_without_division(long long n, long long s,
+                            std::vector<long long> &terms) {
+    terms.resize(s);
+    for (long long l = 0; l < s; ++l) {
+        terms[l] = n - l;
+    }
+    for (long long d = 2; d <= s; ++d) {
+        long long g = d;
+        for (long long l = 0; l < s && g > 1; ++l) {
+            const long long h = std::gcd(terms[l], g);
+            terms[l] /= h;
+            g /= h;
+        }
+    }
+    T res(1);
+    for (long long l = 0; l < s; ++l) {
+        res = res * T(terms[l]);
+    }
+    return res;
+}
+
+// 2 以上 n 以下で m で割った余りが r の数 x についての Σ x^d (0 <= d < degree_count) を求める。
+// x = r + m t (0 <= t < cnt) とおくと Σ x^d = Σ_j C(d, j) r^{d-j} m^j Σ_t t^j であり、
+// Σ_{t<cnt} t^j = Σ_i S(j, i) i! C(cnt, i + 1)（S は第 2 種 Stirling 数）と表せる。
+template <class T> class ResiduePowerSums {
+  public:
+    ResiduePowerSums(long long m, long long degree_count)
+        : m_(m), degree_count_(degree_count),
+          stirling_(degree_count * degree_count, T(0)),
+          coefficients_(degree_count * degree_count, T(0)),
+          binomials_(degree_count + 1), t_sums_(degree_count),
+          r_powers_(degree_count, T(1)) {
+        const long long D = degree_count;
+        // stirling_[j D + i] = S(j, i) i!
+        if (D > 0) {
+            stirling_[0] = T(1);
+        }
+        for (long long j = 1; j < D; ++j) {
+            for (long long i = 1; i <= j; ++i) {
+                stirling_[j * D + i] =
+                    T(i) * (stirling_[(j - 1) * D + i] +
+                            stirling_[(j - 1) * D + i - 1]);
+            }
+        }
+        // coefficients_[d D + j] = C(d, j) m^j
+        std::vector<T> m_powers(D, T(1));
+        for (long long j = 1; j < D; ++j) {
+            m_powers[j] = m_powers[j - 1] * T(m);
+        }
+        std::vector<T> row(D, T(0));
+        for (long long d = 0; d < D; ++d) {
+            for (long long j = d; j > 0; --j) {
+                row[j] = row[j] + row[j - 1];
+            }
+            row[0] = T(1);
+            for (long long j = 0; j <= d; ++j) {
+                coefficients_[d * D + j] = row[j] * m_powers[j];
+            }
+        }
+    }
+
+    // out[d] に求める。d = 0 は個数であるため count_residue_2_to_n で求める。
+    void assign(long long n, long long r, long long one_residue, T *out) {
+        const long long D = degree_count_;
+        out[0] = T(count_residue_2_to_n(n, m_, r, one_residue));
+        if (D == 1) {
+            return;
+        }
+        const long long cnt = r <= n ? (n - r) / m_ + 1 : 0;
+        for (long long s = 1; s <= D; ++s) {
+            binomials_[s] = binomial_without_division<T>(cnt, s, terms_);
+        }
+        for (long long j = 0; j < D; ++j) {
+            T sum(0);
+            for (long long i = 0; i <= j; ++i) {
+                sum = sum + stirling_[j * D + i] * binomials_[i + 1];
+            }
+            t_sums_[j] = sum;
+        }
+        for (long long d = 1; d < D; ++d) {
+            r_powers_[d] = r_powers_[d - 1] * T(r);
+        }
+        for (long long d = 1; d < D; ++d) {
+            T sum(0);
+            for (long long j = 0; j <= d; ++j) {
+                sum = sum + coefficients_[d * D + j] * r_powers_[d - j] *
+                                t_sums_[j];
+            }
+            // x = 1 を除く。x = 0 は d >= 1 では 0 である。
+            if (n >= 1 && r == one_residue) {
+                sum = sum - T(1);
+            }
+            out[d] = sum;
+        }
+    }
+
+  private:
+    long long m_;
+    long long degree_count_;
+    std::vector<T> stirling_;
+    std::vector<T> coefficients_;
+    std::vector<T> binomials_;
+    std::vector<T> t_sums_;
+    std::vector<T> r_powers_;
+    std::vector<long long> terms_;
+};
+
+// Lucy DP のテーブルのうち、m と互いに素な余りの分のみを持つ。
+// values[(i k + c) D + d] は ns[i] 以下の素数 p で m で割った余りが residues[c] のものについての
+// Σ p^d（k = φ(m)、D = degree_count）。
+// 1 つの値に対する k D 個の要素が連続するため、余りについてのループは連続した領域を走査する。
+template <class T> struct PowerSumTable : ResidueClasses {
+    std::vector<long long> ns;
+    long long degree_count = 1;
+    std::vector<T> values;
+};
+
+// 素数の個数のみを持つテーブル (D = 1)。
+struct CoprimeTable : PowerSumTable<long long> {
+    // ns[i] 以下の素数で m で割った余りが r の個数。
+    long long count(long long i, long long r) const {
+        const long long c = class_index[r];
+        if (c >= 0) {
+            return values[i * width() + c];
+        }
+        long long res = 0;
+        for (const long long p : prime_divisors) {
+            if (p % m == r && p <= ns[i]) {
+                ++res;
+            }
+        }
+        return res;
+    }
+};
+
+// x が m と互いに素な素数かどうかを返す。
+// そうであれば target[c] を residues[c] x mod m の添字とし、identity を target が恒等写像かとする。
+// また powers[d] = x^d とする。
+template <class T>
+bool prepare_sieve(const PowerSumTable<T> &table,
+                   const std::vector<char> &composite, long long x,
+                   std::vector<long long> &target, bool &identity,
+                   std::vector<T> &powers) {
+    if (composite[x] || table.class_index[x % table.m] < 0) {
+        return false;
+    }
+    identity = make_target(table, x, target);
+    for (long long d = 1; d < table.degree_count; ++d) {
+        powers[d] = powers[d - 1] * T(x);
+    }
+    return true;
+}
+
+// 素数 x によるふるいのうち、添字 [first, last) の行を更新する。
+// i 行目は n / x に対応する、i より大きい添字 q_idx の行のみを読む。
+// 余りごとに D 個の次数が連続するため、全ての次数で同じ置換先を用いる。次数 d の差分には x^d を掛ける。
+template <class T>
+void sieve_rows(PowerSumTable<T> &table, long long sq, long long x,
+                const std::vector<long long> &target, bool identity,
+                const std::vector<T> &powers, long long first,
+                long long last) {
+    using i64 = long long;
+    const std::vector<i64> &ns = table.ns;
+    const i64 nsz = static_cast<i64>(ns.size());
+    const i64 k = table.width();
+    const i64 D = table.degree_count;
+    const i64 row_size = D * k;
+    T *h = table.values.data();
+    const T *prev_row = h + (nsz - x + 1) * row_size;
+    const i64 direct_index_limit = sq / x;
+    for (i64 i = first; i < last; ++i) {
+        const i64 q_idx = i <= direct_index_limit ? i * x : nsz - ns[i] / x;
+        T *row = h + i * row_size;
+        const T *q_row = h + q_idx * row_size;
+        if (D == 1) {
+            if (identity) {
+                for (i64 c = 0; c < k; ++c) {
+                    row[c] = row[c] - (q_row[c] - prev_row[c]);
+                }
+            } else {
+                for (i64 c = 0; c < k; ++c) {
+                    row[target[c]] =
+                        row[target[c]] - (q_row[c] - prev_row[c]);
+                }
+            }
+            continue;
+        }
+        for (i64 c = 0; c < k; ++c) {
+            T *to = row + (identity ? c : target[c]) * D;
+            const T *q = q_row + c * D;
+            const T *prev = prev_row + c * D;
+            to[0] = to[0] - (q[0] - prev[0]);
+            for (i64 d = 1; d < D; ++d) {
+                to[d] = to[d] - powers[d] * (q[d] - prev[d]);
+            }
+        }
+    }
+}
+
+// ns[i] >= x^2 を満たす i の上限 (exclusive) を返す。last は x - 1 での値。
+inline long long sieve_end(const std::vector<long long> &ns, long long x,
+                           long long last) {
+    while (last > 1 && ns[last - 1] < x * x) {
+        --last;
+    }
+    return last;
+}
+
+// x = 2, ..., x_end - 1 のふるいを thread_count 個のスレッドで行う。
+// x ごとに、更新する行を先頭から [lo, hi) に区切る。hi を lo 行目が読む行の添字とすると、
+// 区間内の行が読む行はいずれも hi 以上で、まだ更新されていない。
+// そのため区間内の行は同時に更新でき、結果はスレッド数によらない。
+template <class T>
+void sieve_parallel(PowerSumTable<T> &table, const std::vector<char> &composite,
+                    long long sq, long long x_end, unsigned thread_count) {
+    using i64 = long long;
+    const std::vector<i64> &ns = table.ns;
+    const i64 nsz = static_cast<i64>(ns.size());
+    std::barrier sync(thread_count);
+    const auto work = [&](unsigned id) {
+        std::vector<i64> target(table.width());
+        bool identity = true;
+        std::vector<T> powers(table.degree_count, T(1));
+        i64 end = nsz;
+        for (i64 x = 2; x < x_end; ++x) {
+            end = sieve_end(ns, x, end);
+            if (!prepare_sieve(table, composite, x, target, identity,
+                               powers)) {
+                continue;
+            }
+            const i64 direct_index_limit = sq / x;
+            for (i64 lo = 1; lo < end;) {
+                const i64 q_idx = lo <= direct_index_limit ? lo * x
+                                                           : nsz - ns[lo] / x;
+                const i64 hi = std::min(end, q_idx);
+                const i64 width = hi - lo;
+                sieve_rows(table, sq, x, target, identity, powers,
+                           lo + width * id / thread_count,
+                           lo + width * (id + 1) / thread_count);
+                sync.arrive_and_wait();
+                lo = hi;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned id = 1; id < thread_count; ++id) {
+        workers.emplace_back(work, id);
+    }
+    work(0);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+// 次数 0, ..., degree_count - 1 のテーブルを、素数ごとに 1 回のふるいでまとめて求める。
+template <class T>
+PowerSumTable<T> make_power_sum_table(long long N, long long m,
+                                      long long degree_count,
+                                      unsigned thread_count) {
     using i64 = long long;
-    std::vector<i64> ns{0};
+    assert(degree_count >= 1);
+    PowerSumTable<T> table;
+    static_cast<ResidueClasses &>(table) = make_residue_classes(m);
+    table.degree_count = degree_count;
+    std::vector<i64> &ns = table.ns;
+    ns.push_back(0);
     for (i64 i = N; i > 0;) {
         ns.push_back(i);
         const i64 q = N / i;
@@ -64,97 +401,407 @@ make_table(long long N, long long m) {
         }
         i = N / (q + 1);
     }
+
     const i64 sq = prime_counting_modulo_internal::integer_sqrt(N);
     const i64 nsz = static_cast<i64>(ns.size());
-    std::vector<std::vector<i64>> h(m, std::vector<i64>(nsz));
+    const i64 k = table.width();
+    const i64 row_size = degree_count * k;
+    table.values.assign(nsz * row_size, T(0));
     const i64 one_residue = m == 1 ? 0 : 1;
-    for (i64 r = 0; r < m; ++r) {
-        for (i64 i = 0; i < nsz; ++i) {
-            h[r][i] = prime_counting_modulo_internal::count_residue_2_to_n(
-                ns[i], m, r, one_residue);
+    ResiduePowerSums<T> initial(m, degree_count);
+    for (i64 i = 1; i < nsz; ++i) {
+        for (i64 c = 0; c < k; ++c) {
+            initial.assign(ns[i], table.residues[c], one_residue,
+                           table.values.data() + (i * k + c) * degree_count);
         }
     }
-    for (i64 x = 2; x <= sq; ++x) {
-        const i64 x_mod = x % m;
-        const i64 x_idx = nsz - x;
-        const i64 prev_idx = nsz - x + 1;
-        if (h[x_mod][x_idx] == h[x_mod][prev_idx]) {
+
+    std::vector<char> composite(sq + 1);
+    for (i64 p = 2; p <= sq / p; ++p) {
+        if (!composite[p]) {
+            for (i64 j = p * p; j <= sq; j += p) {
+                composite[j] = 1;
+            }
+        }
+    }
+
+    if (thread_count == 0) {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+    // 更新する要素数がこれより少ない x は、同期の費用が勝るため 1 スレッドで行う。
+    constexpr i64 min_parallel_work = 1 << 16;
+    i64 x = 2;
+    i64 end = nsz;
+    if (thread_count > 1) {
+        for (; x <= sq; ++x) {
+            end = sieve_end(ns, x, end);
+            if ((end - 1) * row_size < min_parallel_work) {
+                break;
+            }
+        }
+        if (x > 2) {
+            sieve_parallel(table, composite, sq, x, thread_count);
+        }
+    }
+    std::vector<i64> target(k);
+    bool identity = true;
+    std::vector<T> powers(degree_count, T(1));
+    for (; x <= sq; ++x) {
+        end = sieve_end(ns, x, end);
+        if (prepare_sieve(table, composite, x, target, identity, powers)) {
+            sieve_rows(table, sq, x, target, identity, powers, 1, end);
+        }
+    }
+    return table;
+}
+
+inline CoprimeTable make_coprime_table(long long N, long long m,
+                                       unsigned thread_count) {
+    CoprimeTable table;
+    static_cast<PowerSumTable<long long> &>(table) =
+        make_power_sum_table<long long>(N, m, 1, thread_count);
+    return table;
+}
+
+// 全ての余りについて、values[i m + r] の形に並べる。
+inline std::vector<long long> to_flat(const CoprimeTable &table) {
+    const long long m = table.m;
+    const long long k = table.width();
+    const long long nsz = static_cast<long long>(table.ns.size());
+    std::vector<long long> res(nsz * m);
+    for (long long i = 0; i < nsz; ++i) {
+        for (long long c = 0; c < k; ++c) {
+            res[i * m + table.residues[c]] = table.values[i * k + c];
+        }
+    }
+    for (const long long p : table.prime_divisors) {
+        for (long long i = 1; i < nsz && table.ns[i] >= p; ++i) {
+            ++res[i * m + p % m];
+        }
+    }
+    return res;
+}
+
+// 全ての余りについて、values[r][i] の形に並べる。
+template <class T>
+std::vector<std::vector<T>> to_residue_major(const CoprimeTable &table) {
+    const long long m = table.m;
+    const long long k = table.width();
+    const long long nsz = static_cast<long long>(table.ns.size());
+    std::vector<std::vector<T>> res(m, std::vector<T>(nsz));
+    for (long long i = 0; i < nsz; ++i) {
+        for (long long c = 0; c < k; ++c) {
+            res[table.residues[c]][i] =
+                static_cast<T>(table.values[i * k + c]);
+        }
+    }
+    for (const long long p : table.prime_divisors) {
+        for (long long i = 1; i < nsz && table.ns[i] >= p; ++i) {
+            res[p % m][i] = res[p % m][i] + T(1);
+        }
+    }
+    return res;
+}
+
+// [0, n) の位置の集合。削除と、ある位置より前にある要素の個数の取得を O(log n) で行う。
+// 64 個ずつの bit 列と、各語の要素数に関する Fenwick tree で持つ。
+// freeze の後は削除できない代わりに、個数の取得を語ごとの累積和により O(1) で行う。
+class CountingBitset {
+  public:
+    // 全ての位置を含む集合を構築する。
+    explicit CountingBitset(long long n)
+        : words_((n + 63) / 64, ~std::uint64_t{0}), tree_(words_.size() + 1) {
+        if (n % 64 != 0) {
+            words_.back() = (std::uint64_t{1} << (n % 64)) - 1;
+        }
+        const std::size_t w = words_.size();
+        for (std::size_t j = 1; j <= w; ++j) {
+            tree_[j] +=
+                static_cast<std::uint32_t>(std::popcount(words_[j - 1]));
+            const std::size_t parent = j + (j & -j);
+            if (parent <= w) {
+                tree_[parent] += tree_[j];
+            }
+        }
+    }
+
+    bool contains(long long pos) const {
+        return (words_[pos >> 6] >> (pos & 63)) & 1;
+    }
+
+    // pos を含むこと、freeze の前であることを仮定する。
+    void erase(long long pos) {
+        words_[pos >> 6] ^= std::uint64_t{1} << (pos & 63);
+        for (std::size_t j = (pos >> 6) + 1; j < tree_.size(); j += j & -j) {
+            --tree_[j];
+        }
+    }
+
+    // Fenwick tree を、tree_[w] = (語 0, ..., w - 1 の要素数) に置き換える。
+    void freeze() {
+        std::uint32_t sum = 0;
+        for (std::size_t w = 0; w < words_.size(); ++w) {
+            tree_[w] = sum;
+            sum += static_cast<std::uint32_t>(std::popcount(words_[w]));
+        }
+        tree_.back() = sum;
+        frozen_ = true;
+    }
+
+    // [0, pos) にある要素の個数。
+    long long count(long long pos) const {
+        const std::size_t w = pos >> 6;
+        long long res = 0;
+        if ((pos & 63) != 0) {
+            res = std::popcount(words_[w] &
+                                ((std::uint64_t{1} << (pos & 63)) - 1));
+        }
+        if (frozen_) {
+            return res + tree_[w];
+        }
+        for (std::size_t j = w; j > 0; j -= j & -j) {
+            res += tree_[j];
+        }
+        return res;
+    }
+
+  private:
+    std::vector<std::uint64_t> words_;
+    std::vector<std::uint32_t> tree_;
+    bool frozen_ = false;
+};
+
+// Lucy DP のうち、L 以下の値を位置ごとのふるいと CountingBitset で持つ方法。
+// L より大きい値 N / i (i <= N / (L + 1)) のみを Lucy DP と同様に表で持つ。
+// 素数 p ごとに、表の値を (N / (i p) の値) - (p 未満の素数の個数) だけ減らした後、
+// L 以下の p の倍数のうち残っているものを取り除く。N / (i p) <= L であれば CountingBitset に問い合わせる。
+// 各数は高々 1 回しか取り除かれない。p^2 > L となった後は L 以下の値が変わらないため、
+// 累積和に置き換えて O(1) で問い合わせる。計算量 O((φ(m) N)^{2/3} log N)、空間 O((φ(m) N)^{2/3})。
+// 偶数を持たないよう、法を lcm(m, 2) として数えてから m での余りにまとめる。
+inline std::vector<long long> count_with_fenwick(long long N, long long m) {
+    using i64 = long long;
+    const i64 mod = m % 2 == 0 ? m : 2 * m;
+    const ResidueClasses classes = make_residue_classes(mod);
+    const i64 k = classes.width();
+    const i64 sq = prime_counting_modulo_internal::integer_sqrt(N);
+    // L を大きくすると表の更新が減り、ふるいが増える。前者は余りの個数に比例するため、
+    // L = (k N)^{2/3} / 4 とする（定数は実測による）。
+    const double cube_root = std::cbrt(static_cast<double>(k) *
+                                       static_cast<double>(N));
+    const i64 limit = std::min(
+        N, std::max(sq, static_cast<i64>(cube_root * cube_root / 4)));
+    const i64 large_count = N / (limit + 1);
+
+    // large[i k + c] は N / i 以下の、余りが residues[c] の数のうち残っているものの個数。
+    std::vector<i64> large((large_count + 1) * k);
+    const i64 one_residue = 1 % mod;
+    for (i64 i = 1; i <= large_count; ++i) {
+        for (i64 c = 0; c < k; ++c) {
+            large[i * k + c] =
+                prime_counting_modulo_internal::count_residue_2_to_n(
+                    N / i, mod, classes.residues[c], one_residue);
+        }
+    }
+    // 余りが residues[c] の limit 以下の数 residues[c] + mod t を、位置 t で表す。
+    std::vector<CountingBitset> small;
+    for (i64 c = 0; c < k; ++c) {
+        const i64 r = classes.residues[c];
+        small.emplace_back(r <= limit ? (limit - r) / mod + 1 : 0);
+    }
+    if (limit >= 1) {
+        small[classes.class_index[one_residue]].erase(0);
+    }
+    const auto small_count = [&](i64 c, i64 v) {
+        const i64 r = classes.residues[c];
+        return r <= v ? small[c].count((v - r) / mod + 1) : 0;
+    };
+
+    std::vector<char> composite(sq + 1);
+    std::vector<i64> primes_below(k);
+    std::vector<i64> target(k);
+    std::vector<i64> q_values(k);
+    bool frozen = false;
+    for (i64 p = 2; p <= sq; ++p) {
+        if (composite[p]) {
+            continue;
+        }
+        for (i64 j = p * p; j <= sq; j += p) {
+            composite[j] = 1;
+        }
+        const i64 p_class = classes.class_index[p % mod];
+        if (p_class < 0) {
             continue;
         }
-        const i64 x2 = x * x;
-        const i64 direct_index_limit = sq / x;
-        for (i64 i = 1; i < nsz && ns[i] >= x2; ++i) {
-            const i64 n = ns[i];
-            const i64 q = n / x;
-            const i64 q_idx = i <= direct_index_limit ? i * x : nsz - q;
-            if (x_mod == 0) {
-                i64 removed = 0;
-                for (i64 r = 0; r < m; ++r) {
-                    removed += h[r][q_idx] - h[r][prev_idx];
+        if (p * p > limit && !frozen) {
+            // これ以降 limit 以下の値は変わらない。
+            for (CountingBitset &set : small) {
+                set.freeze();
+            }
+            frozen = true;
+        }
+        const bool identity = make_target(classes, p, target);
+        const i64 i_end = std::min(large_count, N / p / p);
+        for (i64 i = 1; i <= i_end; ++i) {
+            const i64 *q_row;
+            if (i * p <= large_count) {
+                q_row = large.data() + i * p * k;
+            } else {
+                const i64 v = N / (i * p);
+                for (i64 c = 0; c < k; ++c) {
+                    q_values[c] = small_count(c, v);
                 }
-                h[0][i] -= removed;
-            } else if (x_mod == 1) {
-                for (i64 r = 0; r < m; ++r) {
-                    h[r][i] -= h[r][q_idx] - h[r][prev_idx];
+                q_row = q_values.data();
+            }
+            i64 *row = large.data() + i * k;
+            if (identity) {
+                for (i64 c = 0; c < k; ++c) {
+                    row[c] -= q_row[c] - primes_below[c];
                 }
             } else {
-                i64 to = 0;
-                for (i64 r = 0; r < m; ++r) {
-                    h[to][i] -= h[r][q_idx] - h[r][prev_idx];
-                    prime_counting_modulo_internal::add_mod_nonzero(to, x_mod,
-                                                                    m);
+                for (i64 c = 0; c < k; ++c) {
+                    row[target[c]] -= q_row[c] - primes_below[c];
                 }
             }
         }
+        // p t (t >= p、t は mod と互いに素) のうち残っているものを取り除く。
+        // t mod mod、p t mod mod、floor(p t / mod) を除算を使わずに更新する。
+        const i64 p_div = p / mod;
+        const i64 p_mod = p % mod;
+        i64 t_mod = p_mod;
+        i64 j_mod = p_mod * p_mod % mod;
+        i64 pos = p * p / mod;
+        for (i64 t = p; t <= limit / p; ++t) {
+            if (classes.class_index[t_mod] >= 0) {
+                CountingBitset &set = small[classes.class_index[j_mod]];
+                if (set.contains(pos)) {
+                    set.erase(pos);
+                }
+            }
+            if (++t_mod == mod) {
+                t_mod = 0;
+            }
+            pos += p_div;
+            j_mod += p_mod;
+            if (j_mod >= mod) {
+                j_mod -= mod;
+                ++pos;
+            }
+        }
+        ++primes_below[p_class];
+    }
+
+    std::vector<i64> res(m);
+    for (i64 c = 0; c < k; ++c) {
+        res[classes.residues[c] % m] +=
+            large_count >= 1 ? large[k + c] : small_count(c, N);
+    }
+    for (const i64 p : classes.prime_divisors) {
+        if (p <= N) {
+            ++res[p % m];
+        }
     }
-    return {std::move(ns), std::move(h)};
+    return res;
 }
 } // namespace prime_counting_modulo_internal
 
 inline std::pair<std::vector<long long>, std::vector<std::vector<long long>>>
-prime_counting_modulo_table(long long N, long long m) {
+prime_counting_modulo_table(long long N, long long m,
+                            unsigned thread_count = 1) {
     assert(N >= 0);
     assert(m > 0);
+    auto table =
+        prime_counting_modulo_internal::make_coprime_table(N, m, thread_count);
+    auto h = prime_counting_modulo_internal::to_residue_major<long long>(table);
+    return {std::move(table.ns), std::move(h)};
+}
 
-    return prime_counting_modulo_internal::make_table(N, m);
+// 並べ替えを行わない版。second[i m + r] が prime_counting_modulo_table の second[r][i] に当たる。
+inline std::pair<std::vector<long long>, std::vector<long long>>
+prime_counting_modulo_flat_table(long long N, long long m,
+                                 unsigned thread_count = 1) {
+    assert(N >= 0);
+    assert(m > 0);
+    auto table =
+        prime_counting_modulo_internal::make_coprime_table(N, m, thread_count);
+    auto values = prime_counting_modulo_internal::to_flat(table);
+    return {std::move(table.ns), std::move(values)};
 }
 
-inline std::vector<long long> prime_counting_modulo(long long N, long long m) {
+// prime_counting_modulo で用いる方法。
+// Auto は thread_count が 1 ならば Fenwick、そうでなければ Lucy を用いる。
+enum class PrimeCountingModuloEngine { Auto, Lucy, Fenwick };
+
+inline std::vector<long long>
+prime_counting_modulo(long long N, long long m, unsigned thread_count = 1,
+                      PrimeCountingModuloEngine engine =
+                          PrimeCountingModuloEngine::Auto) {
     assert(N >= 0);
     assert(m > 0);
+    if (engine == PrimeCountingModuloEngine::Fenwick ||
+        (engine == PrimeCountingModuloEngine::Auto && thread_count == 1)) {
+        return prime_counting_modulo_internal::count_with_fenwick(N, m);
+    }
     std::vector<long long> res(m);
     if (N == 0) {
         return res;
     }
-    const auto table = prime_counting_modulo_internal::make_table(N, m).second;
+    const auto table =
+        prime_counting_modulo_internal::make_coprime_table(N, m, thread_count);
     for (long long r = 0; r < m; ++r) {
-        res[r] = table[r][1];
+        res[r] = table.count(1, r);
     }
     return res;
 }
 
 template <class T>
 std::vector<std::vector<T>>
-prime_counting_modulo_mf_prefix_sum_table(long long N, long long m) {
+prime_counting_modulo_mf_prefix_sum_table(long long N, long long m,
+                                          unsigned thread_count = 1) {
     assert(N >= 0);
     assert(m > 0);
     if (N == 0) {
         return std::vector<std::vector<T>>(m);
     }
-    auto table = prime_counting_modulo_internal::make_table(N, m).second;
-    if constexpr (std::is_same_v<T, long long>) {
-        return table;
-    } else {
-        std::vector<std::vector<T>> res(m);
-        for (long long r = 0; r < m; ++r) {
-            res[r].resize(table[r].size());
-            for (long long i = 0; i < static_cast<long long>(table[r].size());
-                 ++i) {
-                res[r][i] = static_cast<T>(table[r][i]);
+    return prime_counting_modulo_internal::to_residue_major<T>(
+        prime_counting_modulo_internal::make_coprime_table(N, m,
+                                                           thread_count));
+}
+
+// second[d][r][i] は first[i] 以下の素数 p で m で割った余りが r のものについての Σ p^d (0 <= d <= k)。
+// first は prime_counting_modulo_table(N, m).first と同じ。
+// T は加減乗算と long long からの変換を持つ型。除算は用いない。
+template <class T>
+std::pair<std::vector<long long>, std::vector<std::vector<std::vector<T>>>>
+prime_power_sum_modulo_table(long long N, long long m, long long k,
+                             unsigned thread_count = 1) {
+    assert(N >= 0);
+    assert(m > 0);
+    assert(k >= 0);
+    const long long D = k + 1;
+    auto table = prime_counting_modulo_internal::make_power_sum_table<T>(
+        N, m, D, thread_count);
+    const long long width = table.width();
+    const long long nsz = static_cast<long long>(table.ns.size());
+    std::vector<std::vector<std::vector<T>>> res(
+        D, std::vector<std::vector<T>>(m, std::vector<T>(nsz, T(0))));
+    for (long long i = 0; i < nsz; ++i) {
+        const T *row = table.values.data() + i * width * D;
+        for (long long c = 0; c < width; ++c) {
+            for (long long d = 0; d < D; ++d) {
+                res[d][table.residues[c]][i] = row[c * D + d];
+            }
+        }
+    }
+    for (const long long p : table.prime_divisors) {
+        T power(1);
+        for (long long d = 0; d < D; ++d) {
+            for (long long i = 1; i < nsz && table.ns[i] >= p; ++i) {
+                res[d][p % m][i] = res[d][p % m][i] + power;
             }
+            power = power * T(p);
         }
-        return res;
     }
+    return {std::move(table.ns), std::move(res)};
 }
 
 #endif
@@ -0,0 +1,268 @@
+#ifndef MATH_NUMBER_THEORY_FIXED_MODULI_GARNER_HPP
+#define MATH_NUMBER_THEORY_FIXED_MODULI_GARNER_HPP
+
+// 互いに素な K 個の固定された法 m_0, ..., m_{K-1} (< 2^32) について、剰余の組から
+// x mod (m_0 ... m_{K-1}) を復元する。多数の組をまとめて処理することを想定する。
+// x = c_0 + c_1 m_0 + c_2 m_0 m_1 + ... と表したときの係数 c_i は、
+// c_i = (r_i inv_i + Σ_{j<i} c_j w_{ij}) mod m_i と表せる。
+// inv_i と w_{ij} は法のみから定まるため、構築時に一度だけ求める。
+// 定数との剰余乗算は、定数ごとに floor(w 2^32 / m) を前計算する方法（Shoup の方法）で行う。
+// 一括処理では係数を列ごとに求め、内側のループを分岐のない 64 bit 演算のみにする。
+// 構築 O(K^2 log V)、1 組あたり O(K^2)。
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../../internal/int128.hpp"
+#include "generalized-garner.hpp"
+
+namespace fixed_moduli_garner_internal {
+// 法 m の定数 w を掛ける。0 <= w < m < 2^32 を仮定する。
+struct ShoupMultiplier {
+    std::uint64_t w = 0;
+    std::uint64_t w_shoup = 0;
+
+    ShoupMultiplier() = default;
+
+    ShoupMultiplier(std::uint64_t value, std::uint64_t m)
+        : w(value), w_shoup((value << 32) / m) {}
+
+    // c < 2^32 について、c w mod m と合同な [0, 2m) の値を返す。
+    std::uint64_t multiply_lazy(std::uint64_t c, std::uint64_t m) const {
+        const std::uint64_t q = (c * w_shoup) >> 32;
+        return c * w - q * m;
+    }
+};
+
+// [0, 2m) の値を [0, m) に直す。
+inline std::uint64_t reduce_once(std::uint64_t x, std::uint64_t m) {
+    return x - (x >= m ? m : 0);
+}
+} // namespace fixed_moduli_garner_internal
+
+template <std::size_t K> class FixedModuliGarner {
+    static_assert(K >= 1, "K must be positive.");
+
+  public:
+    explicit FixedModuliGarner(const std::array<std::uint32_t, K> &moduli) {
+        namespace gg_internal = generalized_garner_internal;
+        using Multiplier = fixed_moduli_garner_internal::ShoupMultiplier;
+        for (std::size_t i = 0; i < K; ++i) {
+            assert(moduli[i] >= 1);
+            moduli_[i] = moduli[i];
+        }
+        for (std::size_t i = 0; i < K; ++i) {
+            const std::uint64_t m = moduli_[i];
+            const gg_internal::ModMultiplier<std::uint64_t> multiplier(m);
+            // prefix[j] = m_0 ... m_{j-1} mod m_i
+            std::array<std::uint64_t, K> prefix{};
+            prefix[0] = 1 % m;
+            for (std::size_t j = 1; j <= i; ++j) {
+                assert(gg_internal::gcd(moduli_[j - 1], m) == 1);
+                prefix[j] = prefix[j - 1] * (moduli_[j - 1] % m) % m;
+            }
+            const std::uint64_t inv =
+                prefix[i] == 0 ? 0
+                               : gg_internal::inv_mod(prefix[i], multiplier);
+            weight_[i][i] = Multiplier(inv, m);
+            for (std::size_t j = 0; j < i; ++j) {
+                const std::uint64_t w = prefix[j] * inv % m;
+                weight_[i][j] = Multiplier(w == 0 ? 0 : m - w, m);
+            }
+        }
+        // m_0 ... m_{K-1} < 2^127 かどうかを、積が桁あふれしないように調べる。
+        const UInt128 max_value = UInt128::from_words(~std::uint64_t{0} >> 1,
+                                                      ~std::uint64_t{0});
+        UInt128 product = 1;
+        for (std::size_t i = 0; i < K && fits_int128_; ++i) {
+            fits_int128_ = product <= max_value / UInt128(moduli_[i]);
+            product *= UInt128(moduli_[i]);
+        }
+    }
+
+    std::uint32_t modulus(std::size_t i) const {
+        return static_cast<std::uint32_t>(moduli_[i]);
+    }
+
+    // [0, m_0 ... m_{K-1}) の解を返す。
+    // 前提: 0 <= residues[i] < m_i、m_0 ... m_{K-1} < 2^127。
+    NicheLibrary::Int128
+    reconstruct(const std::array<std::uint32_t, K> &residues) const {
+        assert(fits_int128_);
+        std::array<std::uint64_t, K> digits;
+        for (std::size_t i = 0; i < K; ++i) {
+            digits[i] = digit(i, residues[i], digits.data(), 1, 0);
+        }
+        return to_int128(digits.data(), 1, 0);
+    }
+
+    // 解を target で割った余りを返す。前提: 0 <= residues[i] < m_i、1 <= target < 2^32。
+    std::uint32_t
+    reconstruct_modulo(const std::array<std::uint32_t, K> &residues,
+                       std::uint32_t target) const {
+        const auto radix = make_radix(target);
+        std::array<std::uint64_t, K> digits;
+        for (std::size_t i = 0; i < K; ++i) {
+            digits[i] = digit(i, residues[i], digits.data(), 1, 0);
+        }
+        return to_modulo(radix, target, digits.data(), 1, 0);
+    }
+
+    // residues[i][e] を e 番目の組の法 m_i の剰余とし、各組の解を返す。
+    std::vector<NicheLibrary::Int128>
+    reconstruct(const std::array<std::vector<std::uint32_t>, K> &residues)
+        const {
+        assert(fits_int128_);
+        const std::size_t n = residues[0].size();
+        std::vector<NicheLibrary::Int128> result(n);
+        for_each_block(residues, [&](const std::uint64_t *digits,
+                                     std::size_t offset, std::size_t size) {
+            for (std::size_t e = 0; e < size; ++e) {
+                result[offset + e] = to_int128(digits, block_size, e);
+            }
+        });
+        return result;
+    }
+
+    // 各組の解を target で割った余りを返す。前提: 1 <= target < 2^32。
+    std::vector<std::uint32_t>
+    reconstruct_modulo(
+        const std::array<std::vector<std::uint32_t>, K> &residues,
+        std::uint32_t target) const {
+        const auto radix = make_radix(target);
+        const std::size_t n = residues[0].size();
+        std::vector<std::uint32_t> result(n);
+        std::array<std::uint64_t, block_size> acc;
+        for_each_block(residues, [&](const std::uint64_t *digits,
+                                     std::size_t offset, std::size_t size) {
+            namespace fmg_internal = fixed_moduli_garner_internal;
+            acc.fill(0);
+            for (std::size_t i = 0; i < K; ++i) {
+                const Multiplier w = radix[i];
+                const std::uint64_t *column = digits + i * block_size;
+                for (std::size_t e = 0; e < size; ++e) {
+                    const std::uint64_t term = fmg_internal::reduce_once(
+                        w.multiply_lazy(column[e], target), target);
+                    acc[e] = fmg_internal::reduce_once(acc[e] + term, target);
+                }
+            }
+            for (std::size_t e = 0; e < size; ++e) {
+                result[offset + e] = static_cast<std::uint32_t>(acc[e]);
+            }
+        });
+        return result;
+    }
+
+  private:
+    using UInt128 = NicheLibrary::UInt128;
+    using Multiplier = fixed_moduli_garner_internal::ShoupMultiplier;
+
+    // 係数を列ごとに求める単位。係数の表が L1 キャッシュに収まる大きさにする。
+    static constexpr std::size_t block_size = 256;
+
+    std::array<std::uint64_t, K> moduli_{};
+    std::array<std::array<Multiplier, K>, K> weight_{};
+    bool fits_int128_ = true;
+
+    // c_i を返す。c_j (j < i) は digits[j stride + index] にあるとする。
+    std::uint64_t digit(std::size_t i, std::uint64_t residue,
+                        const std::uint64_t *digits, std::size_t stride,
+                        std::size_t index) const {
+        namespace fmg_internal = fixed_moduli_garner_internal;
+        const std::uint64_t m = moduli_[i];
+        std::uint64_t acc = fmg_internal::reduce_once(
+            weight_[i][i].multiply_lazy(residue, m), m);
+        for (std::size_t j = 0; j < i; ++j) {
+            const std::uint64_t term = fmg_internal::reduce_once(
+                weight_[i][j].multiply_lazy(digits[j * stride + index], m), m);
+            acc = fmg_internal::reduce_once(acc + term, m);
+        }
+        return acc;
+    }
+
+    // digit を block 内の全ての組について行う。
+    // 内側のループを項ごとに分け、各ループが要素ごとに独立した演算のみからなるようにする。
+    void digit_column(std::size_t i, const std::uint32_t *residues,
+                      std::uint64_t *digits, std::size_t size) const {
+        namespace fmg_internal = fixed_moduli_garner_internal;
+        const std::uint64_t m = moduli_[i];
+        std::uint64_t *out = digits + i * block_size;
+        const Multiplier inv = weight_[i][i];
+        for (std::size_t e = 0; e < size; ++e) {
+            out[e] = fmg_internal::reduce_once(
+                inv.multiply_lazy(residues[e], m), m);
+        }
+        for (std::size_t j = 0; j < i; ++j) {
+            const Multiplier w = weight_[i][j];
+            const std::uint64_t *column = digits + j * block_size;
+            for (std::size_t e = 0; e < size; ++e) {
+                const std::uint64_t term = fmg_internal::reduce_once(
+                    w.multiply_lazy(column[e], m), m);
+                out[e] = fmg_internal::reduce_once(out[e] + term, m);
+            }
+        }
+    }
+
+    // x = c_0 + c_1 m_0 + ... を Horner 法で求める。
+    NicheLibrary::Int128 to_int128(const std::uint64_t *digits,
+                                   std::size_t stride,
+                                   std::size_t index) const {
+        UInt128 x = digits[(K - 1) * stride + index];
+        for (std::size_t i = K - 1; i-- > 0;) {
+            x = x * UInt128(moduli_[i]) + UInt128(digits[i * stride + index]);
+        }
+        return NicheLibrary::Int128::from_words(x.high(), x.low());
+    }
+
+    // radix[i] = m_0 ... m_{i-1} mod target
+    std::array<Multiplier, K> make_radix(std::uint32_t target) const {
+        assert(target >= 1);
+        std::array<Multiplier, K> radix;
+        std::uint64_t value = 1 % target;
+        for (std::size_t i = 0; i < K; ++i) {
+            radix[i] = Multiplier(value, target);
+            value = value * (moduli_[i] % target) % target;
+        }
+        return radix;
+    }
+
+    std::uint32_t to_modulo(const std::array<Multiplier, K> &radix,
+                            std::uint64_t target, const std::uint64_t *digits,
+                            std::size_t stride, std::size_t index) const {
+        namespace fmg_internal = fixed_moduli_garner_internal;
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < K; ++i) {
+            const std::uint64_t term = fmg_internal::reduce_once(
+                radix[i].multiply_lazy(digits[i * stride + index], target),
+                target);
+            acc = fmg_internal::reduce_once(acc + term, target);
+        }
+        return static_cast<std::uint32_t>(acc);
+    }
+
+    // block_size 個ずつ、各組の係数を digits[i block_size + e] に求めて f に渡す。
+    template <class F>
+    void
+    for_each_block(const std::array<std::vector<std::uint32_t>, K> &residues,
+                   F f) const {
+        const std::size_t n = residues[0].size();
+        for (std::size_t i = 0; i < K; ++i) {
+            assert(residues[i].size() == n);
+        }
+        std::vector<std::uint64_t> digits(K * block_size);
+        for (std::size_t offset = 0; offset < n; offset += block_size) {
+            const std::size_t size =
+                n - offset < block_size ? n - offset : block_size;
+            for (std::size_t i = 0; i < K; ++i) {
+                digit_column(i, residues[i].data() + offset, digits.data(),
+                             size);
+            }
+            f(digits.data(), offset, size);
+        }
+    }
+};
+
+#endif
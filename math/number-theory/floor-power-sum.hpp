@@ -0,0 +1,112 @@
+#ifndef MATH_NUMBER_THEORY_FLOOR_POWER_SUM_HPP
+#define MATH_NUMBER_THEORY_FLOOR_POWER_SUM_HPP
+
+// 0 <= k1 <= K1、0 <= k2 <= K2 について、Σ_{i=0}^{n-1} i^k1 floor((a i + b) / m)^k2 をまとめて求める。
+// 0^0 = 1 とする。答えは Value で累積する。Value に剰余環の型を指定してもよい。
+// 格子路に沿った積を universal-euclidean.hpp の万能ユークリッドで求める。
+// n >= 0、m > 0、a >= 0、b >= 0 を仮定する。
+// Value の演算が constexpr であれば、定数式中でも評価できる。
+// 計算量 O(K1 K2 (K1 + K2) log max(a, b, m))。
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "universal-euclidean.hpp"
+
+namespace floor_power_sum_internal {
+template <int K> constexpr auto make_binomial_table() {
+    std::array<std::array<std::uint64_t, K + 1>, K + 1> table{};
+    for (int i = 0; i <= K; ++i) {
+        table[i][0] = 1;
+        for (int j = 1; j <= i; ++j) {
+            table[i][j] = table[i - 1][j - 1] + table[i - 1][j];
+        }
+    }
+    return table;
+}
+
+// 格子路上の区間を表すモノイドの元。right の個数を count_x、up の個数を count_y とし、
+// 区間内の各 right について、それより前の right の個数 x と up の個数 y から x^i y^j の和をとる。
+template <class Value, int K1, int K2> struct Node {
+    static constexpr auto binomial = make_binomial_table<(K1 > K2 ? K1 : K2)>();
+
+    Value count_x = Value(0);
+    Value count_y = Value(0);
+    std::array<std::array<Value, K2 + 1>, K1 + 1> sum{};
+
+    constexpr Node() {
+        for (auto &row : sum) {
+            row.fill(Value(0));
+        }
+    }
+
+    static constexpr Node up() {
+        Node node;
+        node.count_y = Value(1);
+        return node;
+    }
+
+    static constexpr Node right() {
+        Node node;
+        node.count_x = Value(1);
+        node.sum[0][0] = Value(1);
+        return node;
+    }
+
+    // rhs の各 right について、x は lhs.count_x、y は lhs.count_y だけずれる。
+    // 二項展開を x 方向、y 方向の順に行う。
+    friend constexpr Node operator*(const Node &lhs, const Node &rhs) {
+        std::array<Value, K1 + 1> pow_x{};
+        std::array<Value, K2 + 1> pow_y{};
+        pow_x[0] = Value(1);
+        for (int i = 1; i <= K1; ++i) {
+            pow_x[i] = pow_x[i - 1] * lhs.count_x;
+        }
+        pow_y[0] = Value(1);
+        for (int j = 1; j <= K2; ++j) {
+            pow_y[j] = pow_y[j - 1] * lhs.count_y;
+        }
+
+        std::array<std::array<Value, K2 + 1>, K1 + 1> shifted_x{};
+        for (int i = 0; i <= K1; ++i) {
+            for (int j = 0; j <= K2; ++j) {
+                Value value = rhs.sum[i][j];
+                for (int k = 0; k < i; ++k) {
+                    value = value + Value(binomial[i][k]) * pow_x[i - k] *
+                                        rhs.sum[k][j];
+                }
+                shifted_x[i][j] = value;
+            }
+        }
+
+        Node res;
+        res.count_x = lhs.count_x + rhs.count_x;
+        res.count_y = lhs.count_y + rhs.count_y;
+        for (int i = 0; i <= K1; ++i) {
+            for (int j = 0; j <= K2; ++j) {
+                Value value = lhs.sum[i][j] + shifted_x[i][j];
+                for (int k = 0; k < j; ++k) {
+                    value = value + Value(binomial[j][k]) * pow_y[j - k] *
+                                        shifted_x[i][k];
+                }
+                res.sum[i][j] = value;
+            }
+        }
+        return res;
+    }
+};
+} // namespace floor_power_sum_internal
+
+// 返り値を result とすると、result[k1][k2] = Σ_{i=0}^{n-1} i^k1 floor((a i + b) / m)^k2。
+template <class Value, int K1, int K2, class T>
+constexpr std::array<std::array<Value, K2 + 1>, K1 + 1>
+floor_power_sum(T n, T m, T a, T b) {
+    static_assert(std::numeric_limits<T>::is_integer, "T must be integer.");
+    static_assert(K1 >= 0 && K2 >= 0, "K1 and K2 must be non-negative.");
+    using Node = floor_power_sum_internal::Node<Value, K1, K2>;
+    return universal_euclidean(n, a, m, b, Node::up(), Node::right()).sum;
+}
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef MATH_NUMBER_THEORY_FLOOR_SUM_BATCH_HPP
+#define MATH_NUMBER_THEORY_FLOOR_SUM_BATCH_HPP
+
+// 独立な多数の (n, m, a, b) に対して floor_sum をまとめて求める。
+// 複数の問題を別々のレーンに載せ、ユークリッドの互除法と同型の遷移を 1 段ずつ交互に進める。
+// 除算の待ち時間の間に他のレーンの計算を進められるため、1 問ずつ解くより処理量が増える。
+// 終了したレーンには次の問題を読み込み、最後の問題を読み込んだ後はレーンを詰めていく。
+// 各問題の前提と結果は floor_sum と同じである。
+// 計算量 O(Σ log m)。
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "floor-sum.hpp"
+
+namespace floor_sum_batch_internal {
+constexpr int lane_count = 8;
+
+template <class T> struct Lanes {
+    T n[lane_count];
+    T m[lane_count];
+    T a[lane_count];
+    T b[lane_count];
+    T ans[lane_count];
+    std::size_t index[lane_count];
+};
+
+// index 番目の問題をレーン lane に読み込み、a, b を [0, m) に帰着する。
+// 帰着の時点で答えが定まった場合は out に書き込んで false を返す。
+template <class T>
+bool load(Lanes<T> &lanes, int lane, std::size_t index, std::span<const T> n,
+          std::span<const T> m, std::span<const T> a, std::span<const T> b,
+          std::span<T> out) {
+    if constexpr (std::numeric_limits<T>::is_signed) {
+        assert(n[index] >= 0);
+    }
+    assert(m[index] > 0);
+    if (n[index] == 0) {
+        out[index] = 0;
+        return false;
+    }
+    if (n[index] == 1) {
+        out[index] =
+            floor_sum_internal::floor_div_mod(b[index], m[index]).first;
+        return false;
+    }
+
+    T ans = 0;
+    const auto [qa, ra] = floor_sum_internal::floor_div_mod(a[index], m[index]);
+    if (qa != 0) {
+        ans += qa * floor_sum_internal::sum_0_to_n_minus_1(n[index]);
+    }
+    const auto [qb, rb] = floor_sum_internal::floor_div_mod(b[index], m[index]);
+    if (qb != 0) {
+        ans += qb * n[index];
+    }
+    if (ra == 0) {
+        out[index] = ans;
+        return false;
+    }
+
+    lanes.n[lane] = n[index];
+    lanes.m[lane] = m[index];
+    lanes.a[lane] = ra;
+    lanes.b[lane] = rb;
+    lanes.ans[lane] = ans;
+    lanes.index[lane] = index;
+    return true;
+}
+
+// (a / m, b / m) を返す。64 bit 整数型では、値が 32 bit に収まる場合に 32 bit の除算を用いる。
+template <class T> std::pair<T, T> divide_pair(T a, T b, T m) {
+    if constexpr (std::numeric_limits<T>::digits >= 63 &&
+                  std::numeric_limits<T>::digits <= 64) {
+        using U = std::make_unsigned_t<T>;
+        if (((static_cast<U>(a) | static_cast<U>(b) | static_cast<U>(m)) >>
+             32) == 0) {
+            const std::uint32_t a32 = static_cast<std::uint32_t>(a);
+            const std::uint32_t b32 = static_cast<std::uint32_t>(b);
+            const std::uint32_t m32 = static_cast<std::uint32_t>(m);
+            return {static_cast<T>(a32 / m32), static_cast<T>(b32 / m32)};
+        }
+    }
+    return {a / m, b / m};
+}
+
+// レーン lane の遷移を 1 段進め、問題が解き終わった場合は false を返す。
+template <class T> bool step(Lanes<T> &lanes, int lane) {
+    T n = lanes.n[lane];
+    T m = lanes.m[lane];
+    T a = lanes.a[lane];
+    T b = lanes.b[lane];
+    const T y_max = a * n + b;
+    if (y_max < m) {
+        return false;
+    }
+
+    const T new_n = y_max / m;
+    b = y_max - new_n * m;
+    n = new_n;
+    std::swap(m, a);
+
+    // 分岐予測の失敗を避けるため、b >= m かどうかによらず除算する。
+    const auto [qa, qb] = divide_pair(a, b, m);
+    lanes.ans[lane] += qa * floor_sum_internal::sum_0_to_n_minus_1(n) + qb * n;
+    a -= qa * m;
+    b -= qb * m;
+
+    lanes.n[lane] = n;
+    lanes.m[lane] = m;
+    lanes.a[lane] = a;
+    lanes.b[lane] = b;
+    return true;
+}
+} // namespace floor_sum_batch_internal
+
+// すべての i について out[i] = floor_sum(n[i], m[i], a[i], b[i]) とする。
+template <class T>
+void floor_sum_batch(std::span<const T> n, std::span<const T> m,
+                     std::span<const T> a, std::span<const T> b,
+                     std::span<T> out) {
+    static_assert(std::numeric_limits<T>::is_integer, "T must be integer.");
+    namespace fsb_internal = floor_sum_batch_internal;
+    assert(m.size() == n.size() && a.size() == n.size() &&
+           b.size() == n.size() && out.size() == n.size());
+
+    fsb_internal::Lanes<T> lanes;
+    std::size_t next = 0;
+    int active = 0;
+    while (active < fsb_internal::lane_count && next < n.size()) {
+        if (fsb_internal::load(lanes, active, next, n, m, a, b, out)) {
+            ++active;
+        }
+        ++next;
+    }
+
+    while (active > 0) {
+        for (int lane = 0; lane < active;) {
+            if (fsb_internal::step(lanes, lane)) {
+                ++lane;
+                continue;
+            }
+            out[lanes.index[lane]] = lanes.ans[lane];
+
+            bool loaded = false;
+            while (!loaded && next < n.size()) {
+                loaded = fsb_internal::load(lanes, lane, next, n, m, a, b, out);
+                ++next;
+            }
+            if (!loaded) {
+                // 最後のレーンをこの位置に移し、レーンを詰める。
+                --active;
+                lanes.n[lane] = lanes.n[active];
+                lanes.m[lane] = lanes.m[active];
+                lanes.a[lane] = lanes.a[active];
+                lanes.b[lane] = lanes.b[active];
+                lanes.ans[lane] = lanes.ans[active];
+                lanes.index[lane] = lanes.index[active];
+            }
+        }
+    }
+}
+
+// floor_sum_batch を thread_count 個のスレッドで分担して行う。
+// thread_count が 0 の場合は std::thread::hardware_concurrency() を用いる。
+template <class T>
+void floor_sum_batch_parallel(std::span<const T> n, std::span<const T> m,
+                              std::span<const T> a, std::span<const T> b,
+                              std::span<T> out, unsigned thread_count = 0) {
+    assert(m.size() == n.size() && a.size() == n.size() &&
+           b.size() == n.size() && out.size() == n.size());
+    if (thread_count == 0) {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+    // スレッドの起動費用に見合う大きさの塊に分ける。
+    constexpr std::size_t min_chunk_size = 1 << 12;
+    const std::size_t size = n.size();
+    const std::size_t chunk_count = std::min<std::size_t>(
+        thread_count, (size + min_chunk_size - 1) / min_chunk_size);
+    if (chunk_count <= 1) {
+        floor_sum_batch(n, m, a, b, out);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunk_count - 1);
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        const std::size_t first = size * chunk / chunk_count;
+        const std::size_t count = size * (chunk + 1) / chunk_count - first;
+        auto solve_chunk = [=]() {
+            floor_sum_batch(n.subspan(first, count), m.subspan(first, count),
+                            a.subspan(first, count), b.subspan(first, count),
+                            out.subspan(first, count));
+        };
+        if (chunk + 1 == chunk_count) {
+            solve_chunk();
+        } else {
+            threads.emplace_back(solve_chunk);
+        }
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef MATH_NUMBER_THEORY_FLOOR_SUM_FIXED_SLOPE_HPP
+#define MATH_NUMBER_THEORY_FLOOR_SUM_FIXED_SLOPE_HPP
+
+// m, a を固定して、多数の (n, b) について floor_sum(n, m, a, b) を求める。
+// floor_sum の遷移で現れる法と係数の列は a / m の連分数展開のみで定まり、n, b によらない。
+// 構築時にこの列と商を求め、各段の法の逆数を前計算しておく。
+// 64 bit 以下の組み込み整数型では、問い合わせ時の除算を乗算に置き換える。
+// 前提と結果は floor_sum と同じである。
+// 構築 O(log m)、問い合わせ O(log m)。
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../../internal/int128.hpp"
+#include "floor-sum.hpp"
+
+namespace floor_sum_fixed_slope_internal {
+template <class T>
+constexpr bool use_reciprocal_v =
+    std::is_integral_v<T> && std::numeric_limits<T>::digits <= 64;
+
+// 0 以上の x を、前計算した逆数を用いて正の除数 d で割る。
+// 2^l <= d < 2^(l+1) とし、M = min(floor(2^(64+l) / d), 2^64 - 1) とすると、
+// floor(x M / 2^(64+l)) は商またはそれより 1 小さい値であるため、1 回の比較で補正する。
+// 補正は分岐を用いずに行い、多数の除算を交互に進める場合にも分岐予測の失敗を避ける。
+template <class T> class Divider {
+  public:
+    Divider() = default;
+
+    explicit Divider(T divisor) : divisor_(divisor) {
+        if constexpr (use_reciprocal_v<T>) {
+            const std::uint64_t d = static_cast<std::uint64_t>(divisor);
+            shift_ = std::bit_width(d) - 1;
+            if (std::has_single_bit(d)) {
+                reciprocal_ = ~std::uint64_t{0};
+            } else {
+                reciprocal_ = (NicheLibrary::UInt128::from_words(
+                                   std::uint64_t{1} << shift_, 0) /
+                               NicheLibrary::UInt128(d))
+                                  .low();
+            }
+        }
+    }
+
+    T divisor() const { return divisor_; }
+
+    // x / divisor を返し、余りを remainder に書き込む。
+    T div_mod(T x, T &remainder) const {
+        if constexpr (use_reciprocal_v<T>) {
+            const std::uint64_t u = static_cast<std::uint64_t>(x);
+            const std::uint64_t d = static_cast<std::uint64_t>(divisor_);
+            std::uint64_t q =
+                NicheLibrary::UInt128::multiply_u64(u, reciprocal_).high() >>
+                shift_;
+            std::uint64_t r = u - q * d;
+            const std::uint64_t carry = r >= d ? 1 : 0;
+            q += carry;
+            r -= carry * d;
+            remainder = static_cast<T>(r);
+            return static_cast<T>(q);
+        } else {
+            const T q = x / divisor_;
+            remainder = x - q * divisor_;
+            return q;
+        }
+    }
+
+  private:
+    T divisor_ = 1;
+    std::uint64_t reciprocal_ = 0;
+    int shift_ = 0;
+};
+
+// floor_sum の遷移の 1 段。法 m、[0, m) に帰着した係数 a と、次の段で a を帰着する際の商を持つ。
+template <class T> struct Level {
+    Divider<T> m;
+    T a;
+    T next_qa;
+};
+} // namespace floor_sum_fixed_slope_internal
+
+template <class T> class FloorSumFixedSlope {
+  public:
+    FloorSumFixedSlope(T m, T a) {
+        static_assert(std::numeric_limits<T>::is_integer,
+                      "T must be integer.");
+        assert(m > 0);
+        const auto [qa, ra] = floor_sum_internal::floor_div_mod(a, m);
+        qa_ = qa;
+        T current_m = m;
+        T current_a = ra;
+        while (true) {
+            levels_.push_back(
+                {floor_sum_fixed_slope_internal::Divider<T>(current_m),
+                 current_a, T(0)});
+            if (current_a == 0) {
+                break;
+            }
+            const T next_qa = current_m / current_a;
+            levels_.back().next_qa = next_qa;
+            const T next_a = current_m - next_qa * current_a;
+            current_m = current_a;
+            current_a = next_a;
+        }
+    }
+
+    T m() const { return levels_[0].m.divisor(); }
+
+    // Σ_{i=0}^{n-1} floor((a i + b) / m) を返す。
+    T sum(T n, T b) const {
+        if constexpr (std::numeric_limits<T>::is_signed) {
+            assert(n >= 0);
+        }
+        T ans = 0;
+        {
+            const auto [qb, rb] = floor_sum_internal::floor_div_mod(b, m());
+            b = rb;
+            if (qa_ != 0) {
+                ans += qa_ * floor_sum_internal::sum_0_to_n_minus_1(n);
+            }
+            if (qb != 0) {
+                ans += qb * n;
+            }
+        }
+
+        for (std::size_t k = 0; levels_[k].a != 0; ++k) {
+            const auto &level = levels_[k];
+            const T y_max = level.a * n + b;
+            if (y_max < level.m.divisor()) {
+                break;
+            }
+            n = level.m.div_mod(y_max, b);
+
+            // 次の段の法は level.a である。分岐を避けるため、b >= level.a かどうかによらず除算する。
+            T rest = 0;
+            const T qb = levels_[k + 1].m.div_mod(b, rest);
+            b = rest;
+            ans += level.next_qa * floor_sum_internal::sum_0_to_n_minus_1(n) +
+                   qb * n;
+        }
+        return ans;
+    }
+
+  private:
+    T qa_ = 0;
+    std::vector<floor_sum_fixed_slope_internal::Level<T>> levels_;
+};
+
+#endif
@@ -6,14 +6,22 @@
 // T は std::numeric_limits<T>::is_integer が true である型。
 // T が符号付きの場合、a, b は負でもよい（数学的な床除算で扱う）。
 // 中間計算と戻り値が T の範囲に収まることを仮定する。
-// 計算量 O(log m)。
+// floor_sum_modulo<Mod> は和を Mod で累積し、n, m, a, b は T のまま扱う。
+// この場合は戻り値が T に収まる必要はなく、a, b を [0, m) に帰着した後の
+// a n + b、すなわち (m - 1)(n + 1) が T の範囲に収まることのみを仮定する。
+// いずれも constexpr であり、定数式中でも評価できる。
+// make_floor_sum_table<T, N>(m, a, b) は k = 0, 1, ..., N-1 について floor_sum(k, m, a, b) を並べた
+// std::array を返す。constexpr 変数の初期化に用いると、表をコンパイル時に構築できる。
+// 計算量 O(log m)。make_floor_sum_table は O(N)。
 
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <limits>
 #include <utility>
 
 namespace floor_sum_internal {
-template <class T> std::pair<T, T> floor_div_mod(T x, T y) {
+template <class T> constexpr std::pair<T, T> floor_div_mod(T x, T y) {
     if constexpr (std::numeric_limits<T>::is_signed) {
         if (x >= 0 && x < y) {
             return {0, x};
@@ -35,16 +43,26 @@ template <class T> std::pair<T, T> floor_div_mod(T x, T y) {
 }
 
 // Σ_{i=0}^{n-1} i = n(n-1)/2
-template <class T> T sum_0_to_n_minus_1(T n) {
+template <class T> constexpr T sum_0_to_n_minus_1(T n) {
     const T half = n / 2;
     if (n == half * 2) {
         return half * (n - 1);
     }
     return n * half;
 }
+
+// n(n-1)/2 を T で桁あふれさせずに Mod で求める。
+template <class Mod, class T>
+constexpr Mod sum_0_to_n_minus_1_modulo(T n) {
+    const T half = n / 2;
+    if (n == half * 2) {
+        return Mod(half) * Mod(n - 1);
+    }
+    return Mod(n) * Mod(half);
+}
 } // namespace floor_sum_internal
 
-template <class T> T floor_sum(T n, T m, T a, T b) {
+template <class T> constexpr T floor_sum(T n, T m, T a, T b) {
     static_assert(std::numeric_limits<T>::is_integer, "T must be integer.");
     if constexpr (std::numeric_limits<T>::is_signed) {
         assert(n >= 0);
@@ -100,4 +118,87 @@ template <class T> T floor_sum(T n, T m, T a, T b) {
     return ans;
 }
 
+template <class Mod, class T>
+constexpr Mod floor_sum_modulo(T n, T m, T a, T b) {
+    static_assert(std::numeric_limits<T>::is_integer, "T must be integer.");
+    if constexpr (std::numeric_limits<T>::is_signed) {
+        assert(n >= 0);
+    }
+    assert(m > 0);
+    if (n == 0) {
+        return Mod(0);
+    }
+    if (n == 1) {
+        return Mod(floor_sum_internal::floor_div_mod(b, m).first);
+    }
+
+    Mod ans(0);
+
+    {
+        const auto [q, r] = floor_sum_internal::floor_div_mod(a, m);
+        a = r;
+        if (q != 0) {
+            ans += Mod(q) *
+                   floor_sum_internal::sum_0_to_n_minus_1_modulo<Mod>(n);
+        }
+    }
+    {
+        const auto [q, r] = floor_sum_internal::floor_div_mod(b, m);
+        b = r;
+        if (q != 0) {
+            ans += Mod(q) * Mod(n);
+        }
+    }
+    if (a == 0) {
+        return ans;
+    }
+
+    while (true) {
+        const T y_max = a * n + b;
+        if (y_max < m) {
+            break;
+        }
+
+        const T new_n = y_max / m;
+        b = y_max - new_n * m;
+        n = new_n;
+        std::swap(m, a);
+
+        const T qa = a / m;
+        ans += Mod(qa) * floor_sum_internal::sum_0_to_n_minus_1_modulo<Mod>(n);
+        a -= qa * m;
+        if (b >= m) {
+            const T qb = b / m;
+            ans += Mod(qb) * Mod(n);
+            b -= qb * m;
+        }
+    }
+    return ans;
+}
+
+// table[k] = floor_sum(k, m, a, b) (0 <= k < N)。
+// table[k+1] - table[k] = floor((a k + b) / m) であるため、各項を順に加える。
+template <class T, std::size_t N>
+constexpr std::array<T, N> make_floor_sum_table(T m, T a, T b) {
+    static_assert(std::numeric_limits<T>::is_integer, "T must be integer.");
+    assert(m > 0);
+    std::array<T, N> table{};
+    if constexpr (N > 0) {
+        const auto [qa, ra] = floor_sum_internal::floor_div_mod(a, m);
+        auto [qb, rb] = floor_sum_internal::floor_div_mod(b, m);
+        table[0] = 0;
+        for (std::size_t k = 1; k < N; ++k) {
+            table[k] = table[k - 1] + qb;
+            // floor((a k + b) / m) の商と余りを 1 ずつ進める。
+            qb += qa;
+            rb += ra;
+            if (rb >= m) {
+                qb += T(1);
+                rb -= m;
+            }
+        }
+    }
+    return table;
+}
+
 #endif
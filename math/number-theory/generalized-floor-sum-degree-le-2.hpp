@@ -6,14 +6,28 @@
 // ans_02 = Σ floor((a i + b) / m)^2。
 // n >= 0、m > 0 を仮定する。T が符号付きの場合、a, b は負でもよい。
 // T および明示的に指定する Internal は整数型であり、内部計算が内部型の範囲に収まることを仮定する。
+// Int128 で足りない場合は、Internal に internal/fixed-width-int.hpp の Int256 などを指定できる。
+// Internal を指定せず T が 64 bit 以下の組み込み整数型の場合は、まず 64 bit 整数でオーバーフローを検出しながら
+// 答えを組み立て、オーバーフローした場合にのみ Int128 で組み立て直す。
+// generalized_floor_sum_degree_le_2_modulo<Mod> は答えを Mod で累積し、n, m, a, b は T のまま扱う。
+// この場合は答えが T に収まる必要はなく、a, b を [0, m) に帰着した後の a n + b、
+// すなわち (m - 1)(n + 1) が T の範囲に収まることのみを仮定する。
+// generalized_floor_sum_degree_le_2 は x と y を入れ替えながら互除法の各段を T のまま記録し、
+// 深い段から順に閉じた式で答えを組み立てる。内部型は答えの累積にのみ用いる。
+// generalized_floor_sum_degree_le_2_modulo は Mod で 2 による除算を行わないよう、
+// 格子路に沿った積を universal-euclidean.hpp の万能ユークリッドで求める。
+// いずれも constexpr であり、定数式中でも評価できる。
 // 計算量 O(log m)。
 
 #include <cassert>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include <utility>
 
+#include "../../internal/checked-arithmetic.hpp"
 #include "../../internal/int128.hpp"
+#include "universal-euclidean.hpp"
 
 template <class T> struct GeneralizedFloorSumDegreeLe2Result {
     T ans_01;
@@ -40,7 +54,15 @@ template <class T>
 using default_internal_t =
     std::conditional_t<use_int128_by_default_v<T>, NicheLibrary::Int128, T>;
 
-template <class T> std::pair<T, T> floor_div_mod(T x, T y) {
+// 既定の内部型で計算する前に試す、オーバーフローを検出する 64 bit 整数型。
+template <class T>
+using checked_internal_t = NicheLibrary::CheckedInt<
+    std::conditional_t<is_signed_v<T> ||
+                           std::numeric_limits<std::remove_cv_t<T>>::digits <
+                               64,
+                       std::int64_t, std::uint64_t>>;
+
+template <class T> constexpr std::pair<T, T> floor_div_mod(T x, T y) {
     if constexpr (is_signed_v<T>) {
         if (x >= 0 && x < y) {
             return {0, x};
@@ -61,50 +83,82 @@ template <class T> std::pair<T, T> floor_div_mod(T x, T y) {
     }
 }
 
-// Σ_{i=0}^{n-1} i = n(n-1)/2
-template <class State, class Value> Value sum_0_to_n_minus_1(State n) {
+// 以下の和では、偶奇や 3 で割った余りによる分岐が予測しにくいため、
+// 2 や 3 で割る因数を State の値として分岐せずに選んでから Value で掛ける。
+// Value では除算を行わない。
+
+// cond ? x : y を分岐せずに求める。x - y が State に収まることを仮定する。
+template <class State> constexpr State select(bool cond, State x, State y) {
+    return y + static_cast<State>(cond) * (x - y);
+}
+
+// n = 2 half + odd となる floor(n / 2) と odd ∈ {0, 1} を返す。n は負でもよい。
+template <class State> constexpr std::pair<State, State> split_parity(State n) {
     const State half = n / 2;
-    if (n == half * 2) {
-        return static_cast<Value>(half) * static_cast<Value>(n - 1);
-    }
-    return static_cast<Value>(n) * static_cast<Value>(half);
-}
-
-// Σ_{i=0}^{n-1} i^2 = (n-1)n(2n-1)/6
-template <class State, class Value> Value sum_0_to_n_minus_1_sq(State n) {
-    Value a = static_cast<Value>(n - 1);
-    Value b = static_cast<Value>(n);
-    Value c = static_cast<Value>(2) * static_cast<Value>(n) - Value(1);
-    const State n_mod_6 = n % 6;
-    if (n_mod_6 == 0) {
-        b /= Value(6);
-    } else if (n_mod_6 == 1) {
-        a /= Value(6);
-    } else if (n_mod_6 == 2) {
-        b /= Value(2);
-        c /= Value(3);
-    } else if (n_mod_6 == 3) {
-        a /= Value(2);
-        b /= Value(3);
-    } else if (n_mod_6 == 4) {
-        a /= Value(3);
-        b /= Value(2);
+    const State r = n - half * 2;
+    if constexpr (is_signed_v<State>) {
+        const State negative = static_cast<State>(r < 0);
+        return {half - negative, r + negative * 2};
     } else {
-        a /= Value(2);
-        c /= Value(3);
+        return {half, r};
     }
-    return a * b * c;
 }
 
-// Σ_{i=l}^{n-1} i
-template <class State, class Value> Value sum_l_to_n_minus_1(State l, State n) {
-    const State count = n - l;
-    const Value sum = static_cast<Value>(l) + static_cast<Value>(n) - Value(1);
-    const State half_count = count / 2;
-    if (count == half_count * 2) {
-        return static_cast<Value>(half_count) * sum;
-    }
-    return static_cast<Value>(count) * (sum / Value(2));
+// Σ_{i=0}^{n-1} i = n(n-1)/2 = half (n - 1 + odd)。n は負でもよい。
+template <class State, class Value>
+constexpr Value sum_0_to_n_minus_1(State n) {
+    const auto [half, odd] = split_parity(n);
+    return static_cast<Value>(half) *
+           (static_cast<Value>(n) - static_cast<Value>(State(1) - odd));
+}
+
+// Σ_{i=1}^{n} i = n(n+1)/2 = (half + odd)(n + 1 - odd)。n は負でもよい。
+template <class State, class Value> constexpr Value sum_1_to_n(State n) {
+    const auto [half, odd] = split_parity(n);
+    return static_cast<Value>(half + odd) *
+           static_cast<Value>(n - odd + State(1));
+}
+
+// Σ_{i=l}^{n-1} i = half (n - 1 + odd + l) + odd l。
+// ただし n - l = 2 half + odd とする。0 <= l <= n、n > 0 を仮定する。
+template <class State, class Value>
+constexpr Value sum_l_to_n_minus_1(State l, State n) {
+    const auto [half, odd] = split_parity(n - l);
+    return static_cast<Value>(half) * (static_cast<Value>(n - State(1) + odd) +
+                                       static_cast<Value>(l)) +
+           static_cast<Value>(odd * l);
+}
+
+// si = Σ_{i=0}^{n-1} i、si2 = Σ_{i=0}^{n-1} i^2、st = Σ_{i=0}^{n-1} i(i+1)/2。
+template <class Value> struct IndexSums {
+    Value si;
+    Value si2;
+    Value st;
+};
+
+// si = (n-1)n/2、si2 = si (2n-1)/3、st = si (n+1)/3 を求める。n > 0 を仮定する。
+template <class State, class Value>
+constexpr IndexSums<Value> index_sums(State n) {
+    const auto [half, odd] = split_parity(n);
+    // si = a b であり、a は n-1 または (n-1)/2、b は n または n/2 である。
+    const State a = select<State>(odd != 0, half, n - State(1));
+    const State b = select<State>(odd != 0, n, half);
+    // n mod 3 が 0 または 1 ならば b または a が 3 の倍数であり、
+    // 2 ならば 2n-1 と n+1 が 3 の倍数である。
+    const State n_div_3 = n / 3;
+    const State n_mod_3 = n - n_div_3 * 3;
+    const bool mod_3_is_2 = n_mod_3 == 2;
+    const Value si_div_3 =
+        static_cast<Value>(select<State>(n_mod_3 == 1, a / 3, a)) *
+        static_cast<Value>(select<State>(n_mod_3 == 0, b / 3, b));
+    const Value factor_sq =
+        static_cast<Value>(select<State>(mod_3_is_2, n_div_3 * 2 + 1, n)) +
+        static_cast<Value>(select<State>(mod_3_is_2, State(0), n - State(1)));
+    const Value factor_triangular =
+        static_cast<Value>(select<State>(mod_3_is_2, n_div_3 + 1, n)) +
+        static_cast<Value>(State(1) - State(mod_3_is_2));
+    return {static_cast<Value>(a) * static_cast<Value>(b),
+            si_div_3 * factor_sq, si_div_3 * factor_triangular};
 }
 
 template <class Value> struct Result {
@@ -113,78 +167,64 @@ template <class Value> struct Result {
     Value ans_02;
 };
 
-template <class State, class Value>
-Result<Value> solve(State n, State m, State a, State b) {
-    const auto [qa_state, a_mod] = floor_div_mod(a, m);
-    const auto [qb_state, b_mod] = floor_div_mod(b, m);
-    a = a_mod;
-    b = b_mod;
+// 格子路上の区間を表すモノイドの元。right の個数を count_x、up の個数を count_y とし、
+// 区間内の各 right について、それより前の right の個数 x と up の個数 y の和をとる。
+template <class Value> struct Node {
+    Value count_x = Value(0);
+    Value count_y = Value(0);
+    Value sum_x = Value(0);
+    Value sum_y = Value(0);
+    Value sum_xy = Value(0);
+    Value sum_yy = Value(0);
+
+    static constexpr Node up() {
+        Node node;
+        node.count_y = Value(1);
+        return node;
+    }
 
-    const Value qa = static_cast<Value>(qa_state);
-    const Value qb = static_cast<Value>(qb_state);
-
-    Result<Value> base = {0, 0, 0};
-
-    if (a != 0) {
-        const Value y_max_value =
-            (static_cast<Value>(a) * static_cast<Value>(n) +
-             static_cast<Value>(b)) /
-            static_cast<Value>(m);
-
-        const State y_max = static_cast<State>(y_max_value);
-
-        if (y_max != 0) {
-            const Value x_max =
-                y_max_value * static_cast<Value>(m) - static_cast<Value>(b);
-
-            const Value a_value = static_cast<Value>(a);
-            const Value x_max_div_a = x_max / a_value;
-            const Value x_max_mod_a = x_max - x_max_div_a * a_value;
-            const bool has_remainder = x_max_mod_a != Value(0);
-            const State t = static_cast<State>(x_max_div_a) +
-                            (has_remainder ? State(1) : State(0));
-            const State b2 = has_remainder
-                                 ? static_cast<State>(a_value - x_max_mod_a)
-                                 : State(0);
-
-            const auto rec = solve<State, Value>(y_max, a, m, b2);
-
-            const Value head_01 = rec.ans_01;
-            const Value head_11 =
-                ((static_cast<Value>(2) * static_cast<Value>(t) - Value(1)) *
-                     rec.ans_01 -
-                 rec.ans_02) /
-                Value(2);
-            const Value head_02 =
-                (static_cast<Value>(2) * static_cast<Value>(y_max) - Value(1)) *
-                    rec.ans_01 -
-                static_cast<Value>(2) * rec.ans_11;
-
-            const State tail_len_state = n - t;
-            const Value tail_len = static_cast<Value>(tail_len_state);
-            const Value y = static_cast<Value>(y_max);
-
-            const Value tail_01 = tail_len * y;
-            const Value tail_11 = y * sum_l_to_n_minus_1<State, Value>(t, n);
-            const Value tail_02 = tail_len * y * y;
-
-            base = {head_01 + tail_01, head_11 + tail_11, head_02 + tail_02};
-        }
+    static constexpr Node right() {
+        Node node;
+        node.count_x = Value(1);
+        return node;
     }
 
-    const Value n_value = static_cast<Value>(n);
-    if (qa == Value(0)) {
-        if (qb == Value(0)) {
+    // rhs の各 right について、x は lhs.count_x、y は lhs.count_y だけずれる。
+    friend constexpr Node operator*(const Node &lhs, const Node &rhs) {
+        const Value shifted_sum_y = rhs.sum_y + lhs.count_y * rhs.count_x;
+        Node res;
+        res.count_x = lhs.count_x + rhs.count_x;
+        res.count_y = lhs.count_y + rhs.count_y;
+        res.sum_x = lhs.sum_x + rhs.sum_x + lhs.count_x * rhs.count_x;
+        res.sum_y = lhs.sum_y + shifted_sum_y;
+        res.sum_xy = lhs.sum_xy + rhs.sum_xy + lhs.count_y * rhs.sum_x +
+                     lhs.count_x * shifted_sum_y;
+        res.sum_yy = lhs.sum_yy + rhs.sum_yy +
+                     lhs.count_y * (rhs.sum_y + shifted_sum_y);
+        return res;
+    }
+};
+
+// a, b を [0, m) に帰着した問題の答え base に、商 qa, qb の寄与を加える。
+// qa_is_zero、qb_is_zero は商が 0 かどうかを表す（Value に比較を要求しないため）。
+// si = Σ i、si2 = Σ i^2 は必要な場合にのみ呼び出す関数から求める。
+template <class Value, class SumI, class SumI2>
+constexpr Result<Value>
+add_quotients(const Result<Value> &base, const Value &qa, bool qa_is_zero,
+              const Value &qb, bool qb_is_zero, const Value &n_value,
+              SumI si_fn, SumI2 si2_fn) {
+    if (qa_is_zero) {
+        if (qb_is_zero) {
             return base;
         }
-        const Value si = sum_0_to_n_minus_1<State, Value>(n);
+        const Value si = si_fn();
         return {qb * n_value + base.ans_01, qb * si + base.ans_11,
                 qb * qb * n_value + Value(2) * qb * base.ans_01 + base.ans_02};
     }
 
-    const Value si = sum_0_to_n_minus_1<State, Value>(n);
-    const Value si2 = sum_0_to_n_minus_1_sq<State, Value>(n);
-    if (qb == Value(0)) {
+    const Value si = si_fn();
+    const Value si2 = si2_fn();
+    if (qb_is_zero) {
         return {qa * si + base.ans_01, qa * si2 + base.ans_11,
                 qa * qa * si2 + Value(2) * qa * base.ans_11 + base.ans_02};
     }
@@ -197,10 +237,199 @@ Result<Value> solve(State n, State m, State a, State b) {
                  Value(2) * qb * base.ans_01 + base.ans_02;
     return ans;
 }
+
+// [0, m) に帰着した a, b について、格子路に沿った積を万能ユークリッドで求める。
+// Wide は万能ユークリッドで積を含む計算に用いる型で、void の場合は既定の型を用いる。
+template <class State, class Value, class Wide = void>
+constexpr Result<Value> solve_reduced(State n, State m, State a, State b) {
+    const Node<Value> node = universal_euclidean<Wide>(
+        n, a, m, b, Node<Value>::up(), Node<Value>::right());
+    return {node.sum_y, node.sum_xy, node.sum_yy};
+}
+
+// ユークリッドの互除法の 1 段。a, b を [0, m) に帰着したときの商 qa, qb と、
+// 帰着した問題で floor が最大値 y_max をとる最初の添字 t を持つ。
+// y_max = 0 の段が最も深く、それより深い問題を持たない。
+template <class State> struct Step {
+    State n;
+    State qa;
+    State qb;
+    State t;
+    State y_max;
+};
+
+// 帰着した各段の a n + b は (m - 1)(n + 1) 以下である。
+// これが State に収まるかどうかを返す。n >= 0、m > 0 を仮定する。
+template <class State> constexpr bool fits_in_state(State n, State m) {
+    constexpr State max = std::numeric_limits<State>::max();
+    return n < max && m - State(1) <= max / (n + State(1));
+}
+
+// 段を深い方へ順に steps に記録し、段数を返す。
+// a n + b とその m による商と余りのみを Wide で求め、それ以外は State で扱う。
+template <class State, class Wide>
+constexpr int descend(State n, State m, State a, State b, Step<State> *steps) {
+    auto [qa, a_mod] = floor_div_mod(a, m);
+    auto [qb, b_mod] = floor_div_mod(b, m);
+    a = a_mod;
+    b = b_mod;
+    int count = 0;
+    while (true) {
+        Step<State> &step = steps[count++];
+        step = {n, qa, qb, n, State(0)};
+        if (a == 0) {
+            return count;
+        }
+        const Wide c = static_cast<Wide>(a) * static_cast<Wide>(n) +
+                       static_cast<Wide>(b);
+        const Wide y_max_wide = c / static_cast<Wide>(m);
+        const State y_max = static_cast<State>(y_max_wide);
+        if (y_max == 0) {
+            return count;
+        }
+        // x_max = y_max m - b = a n - r より、t = ceil(x_max / a) = n - floor(r / a)、
+        // x と y を入れ替えた問題の切片は r mod a である。
+        const State r =
+            static_cast<State>(c - y_max_wide * static_cast<Wide>(m));
+        const State r_div_a = r / a;
+        step.t = n - r_div_a;
+        step.y_max = y_max;
+
+        n = y_max;
+        b = r - r_div_a * a;
+        qa = m / a;
+        const State next_a = m - qa * a;
+        m = a;
+        a = next_a;
+        qb = State(0);
+    }
+}
+
+// 深い段から順に、各段の答えを x と y を入れ替えた問題の答えから求める。
+// 先頭部分（head）は 1 つ深い段の答えから、floor が y_max をとる末尾部分（tail）と
+// 帰着で生じる商の寄与は閉じた式から求める。
+// Value での除算を避けるため、Σ y^2 の代わりに h = Σ y(y+1)/2 を持ち、最後に戻す。
+template <class State, class Value>
+constexpr Result<Value> fold(const Step<State> *steps, int count) {
+    Value s_01(0), s_11(0), h(0);
+    for (int k = count - 1; k >= 0; --k) {
+        const Step<State> &step = steps[k];
+        if (step.y_max != 0) {
+            const Value t = static_cast<Value>(step.t);
+            const Value y = static_cast<Value>(step.y_max);
+            const Value tail_len = static_cast<Value>(step.n - step.t);
+            const Value head_11 = t * s_01 - h;
+            const Value head_h = y * s_01 - s_11;
+            s_01 += tail_len * y;
+            s_11 = head_11 +
+                   y * sum_l_to_n_minus_1<State, Value>(step.t, step.n);
+            h = head_h + tail_len * sum_1_to_n<State, Value>(step.y_max);
+        }
+        if (step.qa == 0 && step.qb == 0) {
+            continue;
+        }
+        const Value qa = static_cast<Value>(step.qa);
+        const Value qb = static_cast<Value>(step.qb);
+        const Value n = static_cast<Value>(step.n);
+        const IndexSums<Value> sums = index_sums<State, Value>(step.n);
+        // y に qa i + qb を加えたとき、h には (qa i + qb) y と
+        // (qa i + qb)(qa i + qb + 1)/2 の和が加わる。
+        // h の更新には加える前の s_01、s_11 を用いる。
+        if (step.qa != 0) {
+            h += qa * s_11 +
+                 sum_0_to_n_minus_1<State, Value>(step.qa) * sums.si2 +
+                 qa * sums.st;
+            s_11 += qa * sums.si2;
+        }
+        if (step.qb != 0) {
+            h += qb * s_01 + qa * qb * sums.si +
+                 sum_1_to_n<State, Value>(step.qb) * n;
+            s_11 += qb * sums.si;
+            s_01 += qb * n;
+        }
+        s_01 += qa * sums.si;
+    }
+    return {s_01, s_11, h + h - s_01};
+}
+
+// 各段で m は前の段の a になるため、段数はユークリッドの互除法の回数で抑えられる。
+template <class State>
+constexpr int max_steps = std::numeric_limits<State>::digits * 3 / 2 + 4;
+
+// 段を記録し、段数を返す。a n + b が State に収まらない場合のみ Wide を用いる。
+template <class State>
+constexpr int record_steps(State n, State m, State a, State b,
+                           Step<State> *steps) {
+    namespace ue_internal = universal_euclidean_internal;
+    // 帰着後の値は非負であるため、組み込み整数型では符号なしの型で扱う。
+    using Wide = std::conditional_t<
+        ue_internal::is_builtin_64_v<State>, NicheLibrary::UInt128,
+        typename ue_internal::default_wide<std::remove_cv_t<State>>::type>;
+    if constexpr (!std::is_same_v<Wide, State>) {
+        if (!fits_in_state(n, m)) {
+            return descend<State, Wide>(n, m, a, b, steps);
+        }
+    }
+    return descend<State, State>(n, m, a, b, steps);
+}
+
+template <class State, class Value>
+constexpr Result<Value> solve(State n, State m, State a, State b) {
+    Step<State> steps[max_steps<State>];
+    return fold<State, Value>(steps, record_steps(n, m, a, b, steps));
+}
+
+// 前提より a n + b などが State に収まるため、万能ユークリッドの状態も State で扱う。
+template <class State, class Mod>
+constexpr Result<Mod> solve_modulo(State n, State m, State a, State b) {
+    const auto [qa, a_mod] = floor_div_mod(a, m);
+    const auto [qb, b_mod] = floor_div_mod(b, m);
+    const Result<Mod> base =
+        a_mod == 0 ? Result<Mod>{Mod(0), Mod(0), Mod(0)}
+                   : solve_reduced<State, Mod, State>(n, m, a_mod, b_mod);
+    return add_quotients<Mod>(
+        base, Mod(qa), qa == 0, Mod(qb), qb == 0, Mod(n),
+        [n] { return index_sums<State, Mod>(n).si; },
+        [n] { return index_sums<State, Mod>(n).si2; });
+}
+
+// 段を記録した後、まず 64 bit 整数でオーバーフローを検出しながら答えを組み立て、
+// オーバーフローした場合にのみ既定の内部型で組み立て直す。
+template <class T>
+GeneralizedFloorSumDegreeLe2Result<T> solve_checked_first(T n, T m, T a, T b) {
+    using Checked = checked_internal_t<T>;
+    Step<T> steps[max_steps<T>];
+    const int count = record_steps(n, m, a, b, steps);
+    {
+        const NicheLibrary::CheckedIntOverflowScope scope;
+        // y を floor の絶対値の上界とすると、答えや途中の和はおよそ n y (n + y) / 3 以下である。
+        // これが収まらない場合は途中でオーバーフローする可能性が高いため、64 bit での計算を試さない。
+        const Step<T> &top = steps[0];
+        const Checked qa_abs =
+            top.qa < T(0) ? -Checked(top.qa) : Checked(top.qa);
+        const Checked qb_abs =
+            top.qb < T(0) ? -Checked(top.qb) : Checked(top.qb);
+        const Checked n_value(n);
+        const Checked y = qa_abs * (n_value - Checked(1)) + qb_abs +
+                          Checked(top.y_max) + Checked(1);
+        static_cast<void>(n_value * y / Checked(3) * (n_value + y));
+        if (!scope.overflowed()) {
+            const auto checked = fold<T, Checked>(steps, count);
+            if (!scope.overflowed()) {
+                return {static_cast<T>(checked.ans_01),
+                        static_cast<T>(checked.ans_11),
+                        static_cast<T>(checked.ans_02)};
+            }
+        }
+    }
+    const auto res = fold<T, default_internal_t<T>>(steps, count);
+    return {static_cast<T>(res.ans_01), static_cast<T>(res.ans_11),
+            static_cast<T>(res.ans_02)};
+}
 } // namespace generalized_floor_sum_degree_le_2_internal
 
 template <class T, class Internal = void>
-GeneralizedFloorSumDegreeLe2Result<T>
+constexpr GeneralizedFloorSumDegreeLe2Result<T>
 generalized_floor_sum_degree_le_2(T n, T m, T a, T b) {
     namespace gfs_internal = generalized_floor_sum_degree_le_2_internal;
     using Value =
@@ -234,9 +463,42 @@ generalized_floor_sum_degree_le_2(T n, T m, T a, T b) {
         return {q, T(0), static_cast<T>(q_value * q_value)};
     }
 
+    // オーバーフローの検出はスレッドのフラグを用いるため、定数式中では行わない。
+    if constexpr (std::is_void_v<Internal> &&
+                  gfs_internal::use_int128_by_default_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            return gfs_internal::solve_checked_first(n, m, a, b);
+        }
+    }
+
     const auto res = gfs_internal::solve<T, Value>(n, m, a, b);
     return {static_cast<T>(res.ans_01), static_cast<T>(res.ans_11),
             static_cast<T>(res.ans_02)};
 }
 
+template <class Mod, class T>
+constexpr GeneralizedFloorSumDegreeLe2Result<Mod>
+generalized_floor_sum_degree_le_2_modulo(T n, T m, T a, T b) {
+    namespace gfs_internal = generalized_floor_sum_degree_le_2_internal;
+
+    static_assert(gfs_internal::is_integer_v<T>, "T must be integer.");
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, bool>,
+                  "T must not be bool.");
+
+    if constexpr (gfs_internal::is_signed_v<T>) {
+        assert(n >= 0);
+    }
+    assert(m > 0);
+    if (n == 0) {
+        return {Mod(0), Mod(0), Mod(0)};
+    }
+    if (n == 1) {
+        const Mod q(gfs_internal::floor_div_mod(b, m).first);
+        return {q, Mod(0), q * q};
+    }
+
+    const auto res = gfs_internal::solve_modulo<T, Mod>(n, m, a, b);
+    return {res.ans_01, res.ans_11, res.ans_02};
+}
+
 #endif
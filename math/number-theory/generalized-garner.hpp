@@ -5,19 +5,32 @@
 // 各式を x ≡ r_i (mod m_i) に直してから一般の中国剰余定理で合成する。
 // M_i > 0、a, b, m のサイズ一致、返り値が R1, R2 に収まることを仮定する。
 // 係数や法は互いに素でなくてよい。解がなければ (0, 0) を返す。
-// 標準の 64 bit 以下の整数型では剰余乗算に 128 bit 整数型を用いる。
+// 標準の 64 bit 以下の整数型では剰余乗算に 128 bit 整数型と、
+// 法ごとに逆数を前計算した除算器を用いる。
+// Int128 と UInt128 では 256 bit の積を同様に前計算した除算器で割る。
+// Int128 と UInt128 では、最大公約数と逆元を Lehmer の方法で求める。
 // それ以外の整数型では加算と 2 倍による剰余乗算を用いる。
+// 式を 1 つずつ加えて途中の解を求める場合は GarnerAccumulator を用いる。
+// generalized_garner_product_tree は式を平衡な二分木に沿って 2 つずつ合成し、
+// 独立な部分木を複数のスレッドで分担する。
 // 式の個数を N、全ての法と 2 の最大値を V とすると、計算量 O(N log V)。
-// ただし、通常の乗算を使えない型では O(N log^2 V)。
+// ただし、Int128 と UInt128 以外で通常の乗算を使えない型では O(N log^2 V)。
+// GarnerAccumulator::push は 1 回あたり O(log V)（同様に O(log^2 V)）。
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "../../internal/int128.hpp"
+#include "../../internal/uint128-divider.hpp"
 
 namespace generalized_garner_internal {
 template <class T>
@@ -55,7 +68,132 @@ template <class T> T safe_mod(T x, T m) {
     return x;
 }
 
+template <class T>
+constexpr bool use_lehmer_v =
+    std::is_same_v<std::remove_cv_t<T>, NicheLibrary::Int128> ||
+    std::is_same_v<std::remove_cv_t<T>, NicheLibrary::UInt128>;
+
+template <class T> NicheLibrary::UInt128 to_uint128(T x) {
+    return NicheLibrary::UInt128::from_words(x.high(), x.low());
+}
+
+template <class T> T from_uint128(NicheLibrary::UInt128 x) {
+    return T::from_words(x.high(), x.low());
+}
+
+// x を 2^shift 倍したときの上位 64 bit を、さらに 4 で割った値を返す。
+inline std::uint64_t leading_digit(NicheLibrary::UInt128 x, int shift) {
+    const std::uint64_t top =
+        shift == 0 ? x.high()
+                   : (x.high() << shift) | (x.low() >> (64 - shift));
+    return top >> 2;
+}
+
+// Lehmer の方法による（拡張）ユークリッドの互除法。u >= v を仮定し、gcd(u, v) を返す。
+// WithCoefficient のとき、gcd(u, v) ≡ s v (mod u) を満たす s について、
+// |s| を magnitude に、s < 0 かどうかを negative に入れる。
+// 上位 62 bit の近似値に対する互除法を 64 bit 演算で進め、商が確定した分の変換行列を
+// まとめて u, v に掛ける。v < 2^64 になった後は 64 bit の除算で進める。
+// 係数の列 s_i は符号が交互に変わり、|s_{i+1}| = |s_{i-1}| + q_i |s_i| を満たすため、
+// 絶対値と符号を別に持てば剰余乗算を使わずに更新できる。
+template <bool WithCoefficient>
+NicheLibrary::UInt128 lehmer_gcd(NicheLibrary::UInt128 u,
+                                 NicheLibrary::UInt128 v,
+                                 NicheLibrary::UInt128 &magnitude,
+                                 bool &negative) {
+    using U = NicheLibrary::UInt128;
+    // prev, cur は u, v に対応する係数の絶対値。
+    U prev = 0;
+    U cur = 1;
+    bool prev_negative = true;
+    while (v.high() != 0) {
+        const int shift = std::countl_zero(u.high());
+        std::int64_t x = static_cast<std::int64_t>(leading_digit(u, shift));
+        std::int64_t y = static_cast<std::int64_t>(leading_digit(v, shift));
+        std::int64_t a = 1, b = 0, c = 0, d = 1;
+        bool flip = false;
+        while (y + c > 0 && y + d > 0) {
+            // 商 q が (x + b) / (y + d) の商とも一致するかを、除算 1 回と乗算で調べる。
+            const std::int64_t q =
+                static_cast<std::int64_t>(static_cast<std::uint64_t>(x + a) /
+                                          static_cast<std::uint64_t>(y + c));
+            const U upper = U(x + b);
+            const U lower = U(q) * U(y + d);
+            if (lower > upper || upper - lower >= U(y + d)) {
+                break;
+            }
+            a = std::exchange(c, a - q * c);
+            b = std::exchange(d, b - q * d);
+            x = std::exchange(y, x - q * y);
+            flip = !flip;
+        }
+        if (b == 0) {
+            const U q = u / v;
+            u = std::exchange(v, u - q * v);
+            if constexpr (WithCoefficient) {
+                prev = std::exchange(cur, prev + q * cur);
+                prev_negative = !prev_negative;
+            }
+            continue;
+        }
+        // 結果は [0, 2^128) に収まるため、途中の桁あふれは打ち消される。
+        const U next_u = U(a) * u + U(b) * v;
+        v = U(c) * u + U(d) * v;
+        u = next_u;
+        if constexpr (WithCoefficient) {
+            // 行列の各行の成分は符号が異なり、prev と cur の符号も異なる。
+            const auto abs = [](std::int64_t z) {
+                return U(static_cast<std::uint64_t>(z < 0 ? -z : z));
+            };
+            const U next_prev = abs(a) * prev + abs(b) * cur;
+            cur = abs(c) * prev + abs(d) * cur;
+            prev = next_prev;
+            prev_negative = prev_negative != flip;
+        }
+    }
+    if (v != 0) {
+        if (u.high() != 0) {
+            const U q = u / v;
+            u = std::exchange(v, u - q * v);
+            if constexpr (WithCoefficient) {
+                prev = std::exchange(cur, prev + q * cur);
+                prev_negative = !prev_negative;
+            }
+        }
+        std::uint64_t x = u.low();
+        std::uint64_t y = v.low();
+        while (y != 0) {
+            const std::uint64_t q = x / y;
+            x = std::exchange(y, x - q * y);
+            if constexpr (WithCoefficient) {
+                prev = std::exchange(cur, prev + U(q) * cur);
+                prev_negative = !prev_negative;
+            }
+        }
+        u = x;
+    }
+    if constexpr (WithCoefficient) {
+        magnitude = prev;
+        negative = prev_negative;
+    }
+    return u;
+}
+
+// Int128 と UInt128 では Lehmer の方法を用いる。
 template <class T> T gcd(T a, T b) {
+    if constexpr (use_lehmer_v<T>) {
+        if constexpr (is_signed_v<T>) {
+            assert(a >= 0 && b >= 0);
+        }
+        NicheLibrary::UInt128 u = to_uint128(a);
+        NicheLibrary::UInt128 v = to_uint128(b);
+        if (u < v) {
+            std::swap(u, v);
+        }
+        NicheLibrary::UInt128 magnitude;
+        bool negative;
+        return from_uint128<T>(lehmer_gcd<false>(u, v, magnitude, negative));
+    }
     while (b != 0) {
         const T c = a % b;
         a = b;
@@ -72,20 +210,15 @@ template <class T> T add_mod(T a, T b, T m) {
     return a + b;
 }
 
-template <class T> T mul_mod_normalized(T a, T b, T m) {
-    if (a == 0 || b == 0) {
-        return 0;
-    }
-    if (a == 1) {
-        return b;
-    }
-    if (b == 1) {
-        return a;
-    }
-    if constexpr (use_uint128_mul_v<T>) {
-        using U = NicheLibrary::UInt128;
-        return static_cast<T>((U(a) * U(b)) % U(m));
-    } else {
+// 法 m の剰余乗算を行う。同じ法で繰り返し使う場合は 1 回だけ構築する。
+template <class T, bool = use_uint128_mul_v<T>> class ModMultiplier {
+  public:
+    explicit ModMultiplier(T m) : m_(m) {}
+
+    T mod() const { return m_; }
+
+    // 0 <= a, b < m を仮定する。
+    T multiply(T a, T b) const {
         if (a < b) {
             std::swap(a, b);
         }
@@ -93,21 +226,95 @@ template <class T> T mul_mod_normalized(T a, T b, T m) {
         while (b != 0) {
             const T half_b = b / 2;
             if (b != half_b * 2) {
-                res = add_mod(res, a, m);
+                res = add_mod(res, a, m_);
             }
             b = half_b;
             if (b != 0) {
-                a = add_mod(a, a, m);
+                a = add_mod(a, a, m_);
             }
         }
         return res;
     }
+
+  private:
+    T m_;
+};
+
+template <class T> class ModMultiplier<T, true> {
+  public:
+    explicit ModMultiplier(T m) : m_(m), divider_(NicheLibrary::UInt128(m)) {}
+
+    T mod() const { return m_; }
+
+    // 0 <= a, b < m を仮定する。
+    T multiply(T a, T b) const {
+        using U = NicheLibrary::UInt128;
+        return static_cast<T>(divider_.remainder(U(a) * U(b)));
+    }
+
+  private:
+    T m_;
+    NicheLibrary::UInt128Divider divider_;
+};
+
+// NicheLibrary::Int128 と NicheLibrary::UInt128 では、256 bit の積を前計算した除算器で割る。
+template <class T> class WideModMultiplier {
+  public:
+    explicit WideModMultiplier(T m) : m_(m), divider_(to_uint128(m)) {}
+
+    T mod() const { return m_; }
+
+    // 0 <= a, b < m を仮定する。
+    T multiply(T a, T b) const {
+        return from_uint128<T>(
+            divider_.multiply_mod(to_uint128(a), to_uint128(b)));
+    }
+
+  private:
+    T m_;
+    NicheLibrary::UInt128Divider divider_;
+};
+
+template <>
+class ModMultiplier<NicheLibrary::Int128, false>
+    : public WideModMultiplier<NicheLibrary::Int128> {
+  public:
+    using WideModMultiplier::WideModMultiplier;
+};
+
+template <>
+class ModMultiplier<NicheLibrary::UInt128, false>
+    : public WideModMultiplier<NicheLibrary::UInt128> {
+  public:
+    using WideModMultiplier::WideModMultiplier;
+};
+
+template <class T>
+T mul_mod_normalized(T a, T b, const ModMultiplier<T> &multiplier) {
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+    if (a == 1) {
+        return b;
+    }
+    if (b == 1) {
+        return a;
+    }
+    return multiplier.multiply(a, b);
 }
 
-template <class T> T inv_mod(T a, T m) {
+template <class T> T inv_mod(T a, const ModMultiplier<T> &multiplier) {
     if (a == 1) {
         return 1;
     }
+    const T m = multiplier.mod();
+    if constexpr (use_lehmer_v<T>) {
+        const NicheLibrary::UInt128 um = to_uint128(m);
+        NicheLibrary::UInt128 magnitude;
+        bool negative;
+        lehmer_gcd<true>(um, to_uint128(a), magnitude, negative);
+        return from_uint128<T>(negative ? um - magnitude : magnitude);
+    }
     T b = a;
     a = m;
     T x = 0;
@@ -118,7 +325,7 @@ template <class T> T inv_mod(T a, T m) {
         a = b;
         b = c;
         // 初期値と呼び出し元が互いに素を保証することから 0 < q < m。
-        const T qy = mul_mod_normalized(q, y, m);
+        const T qy = mul_mod_normalized(q, y, multiplier);
         const T z = x >= qy ? x - qy : x + (m - qy);
         x = y;
         y = z;
@@ -148,8 +355,9 @@ template <class T> std::pair<T, T> merge_congruence(T r0, T m0, T r1, T m1) {
     }
     const T factor = safe_mod(diff_div_g, u1);
     if (factor != 0) {
-        const T t =
-            mul_mod_normalized(factor, inv_mod(safe_mod(m0 / g, u1), u1), u1);
+        const ModMultiplier<T> multiplier(u1);
+        const T t = mul_mod_normalized(
+            factor, inv_mod(safe_mod(m0 / g, u1), multiplier), multiplier);
         r0 += t * m0;
     }
     m0 *= u1;
@@ -181,11 +389,85 @@ template <class T> std::pair<T, T> solve_linear_congruence(T a, T b, T m) {
     if (b_div_g == 0) {
         return {0, mod};
     }
-    const T rem = mul_mod_normalized(b_div_g, inv_mod(a / g, mod), mod);
+    const ModMultiplier<T> multiplier(mod);
+    const T rem =
+        mul_mod_normalized(b_div_g, inv_mod(a / g, multiplier), multiplier);
     return {rem, mod};
 }
 } // namespace generalized_garner_internal
 
+// 合同式を 1 つずつ加えながら、それまでの式の解 x ≡ r (mod m) を保持する。
+// 解がなくなった後に加えた式は無視し、current() は (0, 0) を返し続ける。
+// snapshot() で現在の状態を記録し、rollback() でその時点に戻す。
+// 状態は (r, m) と式の個数のみであるため、記録と巻き戻しは O(1)。
+template <class R = long long> class GarnerAccumulator {
+    static_assert(generalized_garner_internal::is_integer_v<R>,
+                  "R must be integer.");
+    static_assert(generalized_garner_internal::is_signed_v<R>,
+                  "R must be signed.");
+
+  public:
+    class Snapshot {
+        friend class GarnerAccumulator;
+
+        R r_;
+        R m_;
+        std::size_t size_;
+
+        Snapshot(R r, R m, std::size_t size) : r_(r), m_(m), size_(size) {}
+    };
+
+    GarnerAccumulator() = default;
+
+    // a x ≡ b (mod m) を加え、解が存在し続けるかどうかを返す。
+    template <class T1, class T2, class M> bool push(T1 a, T2 b, M m) {
+        namespace gg_internal = generalized_garner_internal;
+        static_assert(gg_internal::is_integer_v<T1>, "T1 must be integer.");
+        static_assert(gg_internal::is_integer_v<T2>, "T2 must be integer.");
+        static_assert(gg_internal::is_integer_v<M>, "M must be integer.");
+        const R mi = static_cast<R>(m);
+        assert(mi > 0);
+        ++size_;
+        if (m_ == 0) {
+            return false;
+        }
+        const auto [r1, m1] = gg_internal::solve_linear_congruence(
+            static_cast<R>(a), static_cast<R>(b), mi);
+        if (m1 == 0) {
+            r_ = 0;
+            m_ = 0;
+            return false;
+        }
+        const auto [nr, nm] = gg_internal::merge_congruence(r_, m_, r1, m1);
+        r_ = nr;
+        m_ = nm;
+        return m_ != 0;
+    }
+
+    // これまでの式の解を x ≡ r (mod m) としたときの (r, m) を返す。解がなければ (0, 0)。
+    std::pair<R, R> current() const { return {r_, m_}; }
+
+    bool satisfiable() const { return m_ != 0; }
+
+    // これまでに加えた式の個数を返す。
+    std::size_t size() const { return size_; }
+
+    Snapshot snapshot() const { return Snapshot(r_, m_, size_); }
+
+    // 同じオブジェクトの snapshot() で記録した状態に戻す。
+    void rollback(const Snapshot &snapshot) {
+        assert(snapshot.size_ <= size_);
+        r_ = snapshot.r_;
+        m_ = snapshot.m_;
+        size_ = snapshot.size_;
+    }
+
+  private:
+    R r_ = 0;
+    R m_ = 1;
+    std::size_t size_ = 0;
+};
+
 template <class R1 = long long, class R2 = R1, class T1, class T2, class M>
 std::pair<R1, R2> generalized_garner(const std::vector<T1> &a,
                                      const std::vector<T2> &b,
@@ -195,9 +477,6 @@ std::pair<R1, R2> generalized_garner(const std::vector<T1> &a,
     static_assert(gg_internal::is_integer_v<R2>, "R2 must be integer.");
     static_assert(gg_internal::is_signed_v<R1>, "R1 must be signed.");
     static_assert(gg_internal::is_signed_v<R2>, "R2 must be signed.");
-    static_assert(gg_internal::is_integer_v<T1>, "T1 must be integer.");
-    static_assert(gg_internal::is_integer_v<T2>, "T2 must be integer.");
-    static_assert(gg_internal::is_integer_v<M>, "M must be integer.");
 
     using R = std::common_type_t<R1, R2>;
     static_assert(gg_internal::is_integer_v<R>, "R must be integer.");
@@ -205,25 +484,114 @@ std::pair<R1, R2> generalized_garner(const std::vector<T1> &a,
 
     assert(a.size() == b.size());
     assert(a.size() == m.size());
-    R r0 = 0;
-    R m0 = 1;
+    GarnerAccumulator<R> accumulator;
     const std::size_t n = a.size();
     for (std::size_t i = 0; i < n; ++i) {
-        const R mi = static_cast<R>(m[i]);
-        assert(mi > 0);
-        const auto [r1, m1] = gg_internal::solve_linear_congruence(
-            static_cast<R>(a[i]), static_cast<R>(b[i]), mi);
-        if (m1 == 0) {
+        if (!accumulator.push(a[i], b[i], m[i])) {
             return {0, 0};
         }
-        const auto [nr, nm] = gg_internal::merge_congruence(r0, m0, r1, m1);
-        if (nm == 0) {
-            return {0, 0};
+    }
+    const auto [r, mod] = accumulator.current();
+    return {static_cast<R1>(r), static_cast<R2>(mod)};
+}
+
+namespace generalized_garner_internal {
+// 式 [first, last) の解を、葉を leaf_size 個以下の式とする平衡な二分木に沿って合成する。
+// 解がなければ (0, 0) を返す。
+// depth > 0 の間は、左の部分木を別のスレッドで合成する。
+// いずれかの部分木で解がないとわかった場合は failed を立て、他の部分木の合成を打ち切る。
+template <class R, class T1, class T2, class M>
+std::pair<R, R> merge_range(const std::vector<T1> &a, const std::vector<T2> &b,
+                            const std::vector<M> &m, std::size_t first,
+                            std::size_t last, int depth,
+                            std::atomic<bool> &failed) {
+    if (failed.load(std::memory_order_relaxed)) {
+        return {0, 0};
+    }
+    // 葉では式を順に合成する。合成済みの法が次の法の倍数である場合などの速い経路を活かせる。
+    constexpr std::size_t leaf_size = 128;
+    std::pair<R, R> res;
+    if (last - first <= leaf_size) {
+        GarnerAccumulator<R> accumulator;
+        for (std::size_t i = first; i < last; ++i) {
+            if (!accumulator.push(a[i], b[i], m[i])) {
+                break;
+            }
+        }
+        res = accumulator.current();
+    } else {
+        const std::size_t mid = first + (last - first) / 2;
+        std::pair<R, R> left;
+        std::pair<R, R> right;
+        if (depth > 0) {
+            std::thread thread([&] {
+                left = merge_range<R>(a, b, m, first, mid, depth - 1, failed);
+            });
+            right = merge_range<R>(a, b, m, mid, last, depth - 1, failed);
+            thread.join();
+        } else {
+            left = merge_range<R>(a, b, m, first, mid, 0, failed);
+            if (left.second != 0) {
+                right = merge_range<R>(a, b, m, mid, last, 0, failed);
+            }
         }
-        r0 = nr;
-        m0 = nm;
+        if (left.second == 0 || right.second == 0) {
+            res = {0, 0};
+        } else {
+            res = merge_congruence(left.first, left.second, right.first,
+                                   right.second);
+        }
+    }
+    if (res.second == 0) {
+        failed.store(true, std::memory_order_relaxed);
+    }
+    return res;
+}
+} // namespace generalized_garner_internal
+
+// generalized_garner と同じ結果を、式を平衡な二分木に沿って合成して求める。
+// 独立な部分木を thread_count 個以下のスレッドで分担する。
+// thread_count が 0 の場合は std::thread::hardware_concurrency() を用いる。
+template <class R1 = long long, class R2 = R1, class T1, class T2, class M>
+std::pair<R1, R2> generalized_garner_product_tree(const std::vector<T1> &a,
+                                                  const std::vector<T2> &b,
+                                                  const std::vector<M> &m,
+                                                  unsigned thread_count = 0) {
+    namespace gg_internal = generalized_garner_internal;
+    static_assert(gg_internal::is_integer_v<R1>, "R1 must be integer.");
+    static_assert(gg_internal::is_integer_v<R2>, "R2 must be integer.");
+    static_assert(gg_internal::is_signed_v<R1>, "R1 must be signed.");
+    static_assert(gg_internal::is_signed_v<R2>, "R2 must be signed.");
+    static_assert(gg_internal::is_integer_v<T1>, "T1 must be integer.");
+    static_assert(gg_internal::is_integer_v<T2>, "T2 must be integer.");
+    static_assert(gg_internal::is_integer_v<M>, "M must be integer.");
+
+    using R = std::common_type_t<R1, R2>;
+    static_assert(gg_internal::is_integer_v<R>, "R must be integer.");
+    static_assert(gg_internal::is_signed_v<R>, "R must be signed.");
+
+    assert(a.size() == b.size());
+    assert(a.size() == m.size());
+    if (a.empty()) {
+        return {0, 1};
+    }
+    if (thread_count == 0) {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+    // スレッドの起動費用に見合う大きさの部分木のみを別のスレッドで合成する。
+    constexpr std::size_t min_subtree_size = 1 << 10;
+    int depth = 0;
+    while ((1U << depth) < thread_count &&
+           (a.size() >> (depth + 1)) >= min_subtree_size) {
+        ++depth;
+    }
+    std::atomic<bool> failed = false;
+    const auto [r, mod] =
+        gg_internal::merge_range<R>(a, b, m, 0, a.size(), depth, failed);
+    if (mod == 0) {
+        return {0, 0};
     }
-    return {static_cast<R1>(r0), static_cast<R2>(m0)};
+    return {static_cast<R1>(r), static_cast<R2>(mod)};
 }
 
 #endif
@@ -0,0 +1,166 @@
+#ifndef MATH_NUMBER_THEORY_UNIVERSAL_EUCLIDEAN_HPP
+#define MATH_NUMBER_THEORY_UNIVERSAL_EUCLIDEAN_HPP
+
+// 万能ユークリッド。f(i) = floor((p i + r) / q) とし、f(-1) = 0 とする。
+// i = 0, 1, ..., n-1 の順に up^(f(i) - f(i-1)) right を並べた積をモノイド上で求める。
+// right を i に対応する項、up を y 座標の増分とみなすと、直線の下の格子点に関する和を
+// モノイドの積として表せる（Σ i^k1 f(i)^k2 や、行列の積など）。
+// Monoid は結合的な積 lhs * rhs を持ち、Monoid() が単位元である型。
+// n, p, r は非負、q は正を仮定する。
+// n, p, q, r から定まる値は T で扱い、p n + r などの積を含む計算のみ Wide で行う。
+// Wide を省略した場合、p (n - 1) + r が T に収まれば T を用い、
+// そうでなければ 64 bit 以下の整数型では Int128 または UInt128、Int128 と UInt128 では
+// Int256 または UInt256、それ以外では T を用いる。
+// Monoid の演算が constexpr であれば、定数式中でも評価できる。
+// 再帰は行わず、モノイドの元を O(1) 個だけ保持する。
+// 計算量 O(log max(p, q, r)) 回のモノイド演算（累乗を含む）。
+
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "../../internal/checked-arithmetic.hpp"
+#include "../../internal/fixed-width-int.hpp"
+#include "../../internal/int128.hpp"
+
+namespace universal_euclidean_internal {
+template <class T>
+constexpr bool is_builtin_64_v =
+    std::is_integral_v<std::remove_cv_t<T>> &&
+    !std::is_same_v<std::remove_cv_t<T>, bool> &&
+    std::numeric_limits<std::remove_cv_t<T>>::digits <= 64;
+
+template <class T, bool = is_builtin_64_v<T>> struct default_wide {
+    using type = T;
+};
+
+template <class T> struct default_wide<T, true> {
+    using type =
+        std::conditional_t<std::numeric_limits<T>::is_signed,
+                           NicheLibrary::Int128, NicheLibrary::UInt128>;
+};
+
+template <> struct default_wide<NicheLibrary::Int128, false> {
+    using type = NicheLibrary::Int256;
+};
+
+template <> struct default_wide<NicheLibrary::UInt128, false> {
+    using type = NicheLibrary::UInt256;
+};
+
+template <class T, class Wide>
+using resolved_wide_t =
+    std::conditional_t<std::is_void_v<Wide>,
+                       typename default_wide<std::remove_cv_t<T>>::type, Wide>;
+
+// base^exponent。exponent > 0 を仮定する。
+// 単位元との積と、最上位の bit より先の 2 乗を行わない。
+template <class Monoid, class Wide>
+constexpr Monoid pow(Monoid base, Wide exponent) {
+    while (exponent % 2 == Wide(0)) {
+        base = base * base;
+        exponent /= 2;
+    }
+    Monoid result = base;
+    exponent /= 2;
+    while (exponent != Wide(0)) {
+        base = base * base;
+        if (exponent % 2 == Wide(1)) {
+            result = result * base;
+        }
+        exponent /= 2;
+    }
+    return result;
+}
+
+// prefix の後ろに、x = 1, ..., l について up^(g(x) - g(x-1)) right を並べた積を掛けたものを返す。
+// g(x) = floor((p x + r) / q) であり、0 <= r < q を仮定する。
+// 状態は T で持ち、p l + r などの積を含む値のみ Wide で計算する。
+// x と y を入れ替えて内側の問題に進むたびに、積は (左側) (内側の問題の積) (右側) の形になる。
+// 左側を prefix の右に、右側を suffix の左に掛けていくことで、再帰せずに求める。
+template <class Monoid, class T, class Wide>
+constexpr Monoid solve(T p, T q, T r, T l, Monoid up, Monoid right,
+                       Monoid prefix) {
+    Monoid suffix;
+    bool has_suffix = false;
+    while (l != T(0)) {
+        if (p >= q) {
+            right = pow(up, p / q) * right;
+            p %= q;
+        }
+        // p < q、r < q より m <= l であり、m は T に収まる。
+        const T m = static_cast<T>((Wide(p) * Wide(l) + Wide(r)) / Wide(q));
+        if (m == T(0)) {
+            prefix = prefix * pow(right, l);
+            break;
+        }
+        const T skip = (q - r - T(1)) / p;
+        // count >= 1 である。
+        const T count = l - static_cast<T>(
+                                (Wide(q) * Wide(m) - Wide(r) - Wide(1)) /
+                                Wide(p));
+        if (skip != T(0)) {
+            prefix = prefix * pow(right, skip);
+        }
+        prefix = prefix * up;
+        suffix = has_suffix ? pow(right, count) * suffix : pow(right, count);
+        has_suffix = true;
+
+        const T next_r = (q - r - T(1)) % p;
+        q = std::exchange(p, q);
+        r = next_r;
+        l = m - T(1);
+        std::swap(up, right);
+    }
+    return has_suffix ? prefix * suffix : prefix;
+}
+
+// 途中で扱う積は p (n - 1) + r 以下であるため、それが T に収まる場合は T で計算する。
+template <class T> constexpr bool fits_in_native(T n, T p, T r) {
+    if constexpr (is_builtin_64_v<T>) {
+        T product;
+        return !NicheLibrary::mul_overflow<T>(p, n - T(1), product) &&
+               !NicheLibrary::add_overflow<T>(product, r, product);
+    } else {
+        return false;
+    }
+}
+
+template <class Monoid, class T, class Wide>
+constexpr Monoid solve_from_zero(T n, T p, T q, T r, const Monoid &up,
+                                 const Monoid &right) {
+    const T r_div_q = r / q;
+    Monoid prefix = r_div_q == T(0) ? right : pow(up, r_div_q) * right;
+    return solve<Monoid, T, Wide>(p, q, r - r_div_q * q, n - T(1), up, right,
+                                  std::move(prefix));
+}
+} // namespace universal_euclidean_internal
+
+template <class Wide = void, class T, class Monoid>
+constexpr Monoid universal_euclidean(T n, T p, T q, T r, const Monoid &up,
+                                     const Monoid &right) {
+    namespace ue_internal = universal_euclidean_internal;
+    using W = ue_internal::resolved_wide_t<T, Wide>;
+    static_assert(std::numeric_limits<std::remove_cv_t<T>>::is_integer,
+                  "T must be integer.");
+    static_assert(std::numeric_limits<W>::is_integer, "Wide must be integer.");
+
+    if constexpr (std::numeric_limits<std::remove_cv_t<T>>::is_signed) {
+        assert(n >= 0 && p >= 0 && r >= 0);
+    }
+    assert(q > 0);
+    if (n == 0) {
+        return Monoid();
+    }
+
+    if constexpr (std::is_void_v<Wide>) {
+        if (ue_internal::fits_in_native(n, p, r)) {
+            return ue_internal::solve_from_zero<Monoid, T, T>(n, p, q, r, up,
+                                                              right);
+        }
+    }
+    return ue_internal::solve_from_zero<Monoid, T, W>(n, p, q, r, up, right);
+}
+
+#endif
@@ -0,0 +1,171 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+#include "../internal/checked-arithmetic.hpp"
+#include "../internal/int128.hpp"
+
+namespace {
+namespace checked_internal = NicheLibrary::checked_arithmetic_internal;
+using NicheLibrary::CheckedInt;
+using NicheLibrary::CheckedIntOverflowScope;
+using NicheLibrary::Int128;
+
+template <class T, class Wide> bool fits(Wide value) {
+    return Wide(std::numeric_limits<T>::min()) <= value &&
+           value <= Wide(std::numeric_limits<T>::max());
+}
+
+// 8 bit の整数型について、すべての組を int による計算と比較する。
+template <class T> void test_exhaustive() {
+    const int low = std::numeric_limits<T>::min();
+    const int high = std::numeric_limits<T>::max();
+    for (int x = low; x <= high; ++x) {
+        for (int y = low; y <= high; ++y) {
+            const T lhs = static_cast<T>(x);
+            const T rhs = static_cast<T>(y);
+            const int expected[] = {x + y, x - y, x * y};
+            T results[6];
+            const bool overflows[] = {
+                NicheLibrary::add_overflow(lhs, rhs, results[0]),
+                NicheLibrary::sub_overflow(lhs, rhs, results[1]),
+                NicheLibrary::mul_overflow(lhs, rhs, results[2]),
+                checked_internal::portable_add_overflow(lhs, rhs, results[3]),
+                checked_internal::portable_sub_overflow(lhs, rhs, results[4]),
+                checked_internal::portable_mul_overflow(lhs, rhs, results[5])};
+            for (int i = 0; i < 6; ++i) {
+                const int value = expected[i % 3];
+                assert(overflows[i] == !fits<T>(value));
+                assert(results[i] == static_cast<T>(value));
+            }
+        }
+    }
+}
+
+// 64 bit の整数型について、Int128 による計算と比較する。
+template <class T> void test_64bit() {
+    auto check = [](T lhs, T rhs) {
+        const Int128 x(lhs);
+        const Int128 y(rhs);
+        const Int128 expected[] = {x + y, x - y, x * y};
+        T results[6];
+        const bool overflows[] = {
+            NicheLibrary::add_overflow(lhs, rhs, results[0]),
+            NicheLibrary::sub_overflow(lhs, rhs, results[1]),
+            NicheLibrary::mul_overflow(lhs, rhs, results[2]),
+            checked_internal::portable_add_overflow(lhs, rhs, results[3]),
+            checked_internal::portable_sub_overflow(lhs, rhs, results[4]),
+            checked_internal::portable_mul_overflow(lhs, rhs, results[5])};
+        for (int j = 0; j < 6; ++j) {
+            const Int128 value = expected[j % 3];
+            assert(overflows[j] == !fits<T>(value));
+            assert(results[j] == static_cast<T>(value));
+        }
+    };
+
+    constexpr T min = std::numeric_limits<T>::min();
+    constexpr T max = std::numeric_limits<T>::max();
+    const T edges[] = {min,
+                       static_cast<T>(min + 1),
+                       static_cast<T>(-1),
+                       0,
+                       1,
+                       2,
+                       static_cast<T>(std::uint64_t{1} << 32),
+                       static_cast<T>(max / 2),
+                       static_cast<T>(max / 2 + 1),
+                       static_cast<T>(max - 1),
+                       max};
+    for (const T lhs : edges) {
+        for (const T rhs : edges) {
+            check(lhs, rhs);
+        }
+    }
+
+    std::uint64_t state = 1;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 200000; ++i) {
+        const int shift = static_cast<int>(next() % 64);
+        const T lhs = static_cast<T>(next() >> shift);
+        const T rhs = static_cast<T>(next() >> (63 - shift));
+        check(lhs, rhs);
+    }
+}
+
+void test_checked_int() {
+    using Checked = CheckedInt<std::int64_t>;
+    constexpr std::int64_t max = std::numeric_limits<std::int64_t>::max();
+    constexpr std::int64_t min = std::numeric_limits<std::int64_t>::min();
+
+    {
+        const CheckedIntOverflowScope scope;
+        Checked value = 3;
+        value = value * Checked(max / 4) - Checked(5);
+        value /= Checked(-3);
+        value %= Checked(1000);
+        assert(value.value() == (3 * (max / 4) - 5) / -3 % 1000);
+        assert(Checked(-7) < Checked(2));
+        assert(static_cast<int>(Checked(42)) == 42);
+        assert(!scope.overflowed());
+    }
+    {
+        const CheckedIntOverflowScope outer;
+        {
+            const CheckedIntOverflowScope inner;
+            const Checked value = Checked(max) + Checked(1);
+            assert(value.value() == min);
+            assert(inner.overflowed());
+        }
+        // 内側の範囲で起きたオーバーフローは外側に伝わらない。
+        assert(!outer.overflowed());
+        assert(-Checked(min) == Checked(min));
+        assert(outer.overflowed());
+    }
+    {
+        const CheckedIntOverflowScope scope;
+        assert(Checked(min) / Checked(-1) == Checked(min));
+        assert(scope.overflowed());
+    }
+    {
+        const CheckedIntOverflowScope scope;
+        assert(Checked(5) / Checked(0) == Checked(0));
+        assert(scope.overflowed());
+    }
+    {
+        const CheckedIntOverflowScope scope;
+        const Checked value = std::numeric_limits<std::uint64_t>::max();
+        assert(value.value() == -1);
+        assert(scope.overflowed());
+    }
+    {
+        const CheckedIntOverflowScope scope;
+        const CheckedInt<std::uint32_t> value =
+            CheckedInt<std::uint32_t>(2) - CheckedInt<std::uint32_t>(3);
+        assert(value.value() == 0xffffffffU);
+        assert(scope.overflowed());
+    }
+}
+} // namespace
+
+int main() {
+    static_assert(std::numeric_limits<CheckedInt<std::int64_t>>::digits == 63,
+                  "CheckedInt must have the same digits as its value type.");
+    static_assert(std::numeric_limits<CheckedInt<std::uint8_t>>::max() ==
+                      CheckedInt<std::uint8_t>(255),
+                  "CheckedInt must have the same range as its value type.");
+
+    test_exhaustive<std::int8_t>();
+    test_exhaustive<std::uint8_t>();
+    test_64bit<std::int64_t>();
+    test_64bit<std::uint64_t>();
+    test_checked_int();
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+// competitive-verifier: STANDALONE
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../internal/fixed-width-int.hpp"
+#include "../internal/int128.hpp"
+#include "../math/number-theory/fixed-moduli-garner.hpp"
+#include "../math/number-theory/generalized-garner.hpp"
+
+namespace {
+// generalized_garner で求めた解を Int256 で返す。
+template <std::size_t K>
+NicheLibrary::Int256 expected(const std::array<std::uint32_t, K> &moduli,
+                              const std::array<std::uint32_t, K> &residues) {
+    using NicheLibrary::Int256;
+    std::vector<Int256> a(K, Int256(1));
+    std::vector<Int256> b;
+    std::vector<Int256> m;
+    for (std::size_t i = 0; i < K; ++i) {
+        b.push_back(Int256(residues[i]));
+        m.push_back(Int256(moduli[i]));
+    }
+    const auto [r, mod] = generalized_garner<Int256>(a, b, m);
+    assert(mod != Int256(0));
+    return r;
+}
+
+template <std::size_t K>
+void check(const std::array<std::uint32_t, K> &moduli, bool exact,
+           std::size_t n) {
+    using NicheLibrary::Int128;
+    using NicheLibrary::Int256;
+    const FixedModuliGarner<K> garner(moduli);
+    const std::uint32_t targets[] = {1, 2, 998244353, 1000000007,
+                                     4294967291U};
+    std::uint64_t state = moduli[0] + n;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    std::array<std::vector<std::uint32_t>, K> columns;
+    for (std::size_t e = 0; e < n; ++e) {
+        for (std::size_t i = 0; i < K; ++i) {
+            // 両端の値を多めに含める。
+            const std::uint64_t kind = next() % 4;
+            std::uint32_t value =
+                static_cast<std::uint32_t>(next() % moduli[i]);
+            if (kind == 0) {
+                value = 0;
+            } else if (kind == 1) {
+                value = moduli[i] - 1;
+            }
+            columns[i].push_back(value);
+        }
+    }
+
+    std::vector<Int128> exact_results;
+    if (exact) {
+        exact_results = garner.reconstruct(columns);
+        assert(exact_results.size() == n);
+    }
+    std::vector<std::vector<std::uint32_t>> modulo_results;
+    for (const std::uint32_t target : targets) {
+        modulo_results.push_back(garner.reconstruct_modulo(columns, target));
+        assert(modulo_results.back().size() == n);
+    }
+
+    for (std::size_t e = 0; e < n; ++e) {
+        std::array<std::uint32_t, K> residues;
+        for (std::size_t i = 0; i < K; ++i) {
+            residues[i] = columns[i][e];
+        }
+        const Int256 x = expected(moduli, residues);
+        if (exact) {
+            const Int128 single = garner.reconstruct(residues);
+            assert(single == exact_results[e]);
+            assert(Int256(single) == x);
+        }
+        for (std::size_t t = 0; t < std::size(targets); ++t) {
+            const Int256 want = x % Int256(targets[t]);
+            assert(Int256(modulo_results[t][e]) == want);
+            assert(Int256(garner.reconstruct_modulo(residues, targets[t])) ==
+                   want);
+        }
+    }
+}
+} // namespace
+
+int main() {
+    // 畳み込みでよく用いる素数の組。
+    check<1>({998244353}, true, 300);
+    check<2>({998244353, 167772161}, true, 300);
+    check<3>({998244353, 167772161, 469762049}, true, 1000);
+    check<4>({998244353, 167772161, 469762049, 754974721}, true, 300);
+    check<5>({998244353, 167772161, 469762049, 754974721, 1224736769}, false,
+             300);
+
+    // 2^32 に近い法、合成数の法、1 を含む法。
+    check<3>({4294967291U, 4294967279U, 4294967231U}, true, 300);
+    check<4>({4294967291U, 4294967279U, 4294967231U, 4294967197U}, false,
+             300);
+    check<4>({4, 9, 25, 49}, true, 300);
+    check<3>({1, 7, 1}, true, 100);
+    check<2>({1U << 31, 3}, true, 100);
+
+    return 0;
+}
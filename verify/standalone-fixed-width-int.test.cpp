@@ -0,0 +1,193 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#include "../internal/fixed-width-int.hpp"
+#include "../internal/int128.hpp"
+
+namespace {
+using NicheLibrary::Int128;
+using NicheLibrary::Int256;
+using NicheLibrary::IntN;
+using NicheLibrary::UInt128;
+using NicheLibrary::UInt256;
+using NicheLibrary::UIntN;
+
+// 上位の語を確率的に 0 にして、語長の異なる値を作る。
+template <std::size_t Words, class Next> UIntN<Words> random_value(Next &next) {
+    typename UIntN<Words>::word_array words{};
+    const std::size_t length = next() % Words + 1;
+    for (std::size_t i = 0; i < length; ++i) {
+        words[i] = next();
+        if (next() % 8 == 0) {
+            words[i] = next() % 2 == 0 ? 0 : ~std::uint64_t{};
+        }
+    }
+    return UIntN<Words>::from_words(words);
+}
+
+UInt128 to_uint128(const UIntN<2> &value) {
+    return UInt128::from_words(value.word(1), value.word(0));
+}
+
+Int128 to_int128(const IntN<2> &value) {
+    return Int128::from_words(value.word(1), value.word(0));
+}
+
+// 2 語の場合は UInt128, Int128 と結果が一致することを確かめる。
+void test_two_words() {
+    std::uint64_t state = 1;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 20000; ++i) {
+        const UIntN<2> a = random_value<2>(next);
+        const UIntN<2> b = random_value<2>(next);
+        const UInt128 x = to_uint128(a);
+        const UInt128 y = to_uint128(b);
+        assert(to_uint128(a + b) == x + y);
+        assert(to_uint128(a - b) == x - y);
+        assert(to_uint128(a * b) == x * y);
+        assert((a < b) == (x < y));
+        if (y != UInt128{}) {
+            assert(to_uint128(a / b) == x / y);
+            assert(to_uint128(a % b) == x % y);
+        }
+
+        const IntN<2> s = IntN<2>::from_words(a.words());
+        const IntN<2> t = IntN<2>::from_words(b.words());
+        const Int128 u = to_int128(s);
+        const Int128 v = to_int128(t);
+        assert((s < t) == (u < v));
+        assert(to_int128(s * t) == u * v);
+        if (v != Int128{} &&
+            !(u == std::numeric_limits<Int128>::min() && v == Int128(-1))) {
+            assert(to_int128(s / t) == u / v);
+            assert(to_int128(s % t) == u % v);
+        }
+    }
+}
+
+template <std::size_t Words> void test_division_identity() {
+    std::uint64_t state = Words;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 20000; ++i) {
+        const UIntN<Words> a = random_value<Words>(next);
+        const UIntN<Words> b = random_value<Words>(next);
+        if (b == UIntN<Words>{}) {
+            continue;
+        }
+        UIntN<Words> q;
+        UIntN<Words> r;
+        UIntN<Words>::div_mod(a, b, q, r);
+        assert(r < b);
+        assert(q * b + r == a);
+        if (q != UIntN<Words>{}) {
+            // q b が桁あふれしていないことを確かめる。
+            assert(q * b / q == b);
+        }
+
+        const IntN<Words> s = IntN<Words>::from_words(a.words());
+        const IntN<Words> t = IntN<Words>::from_words(b.words());
+        if (s == std::numeric_limits<IntN<Words>>::min() && t == -1) {
+            continue;
+        }
+        const IntN<Words> sq = s / t;
+        const IntN<Words> sr = s % t;
+        assert(sq * t + sr == s);
+        assert(sr == 0 || sr.is_negative() == s.is_negative());
+        assert((sr < 0 ? -sr : sr) < (t < 0 ? -t : t));
+    }
+}
+
+template <class T>
+void test_round_trip(const T &value, const std::string &text) {
+    std::stringstream output;
+    output << value;
+    assert(output.str() == text);
+
+    std::stringstream input(text);
+    T parsed;
+    input >> parsed;
+    assert(parsed == value);
+}
+
+void test_io() {
+    UInt256 power = 1;
+    std::string text = "1";
+    for (int i = 0; i <= 77; ++i) {
+        test_round_trip(power, text);
+        if (i <= 76) {
+            test_round_trip(-Int256::from_words(power.words()), "-" + text);
+        }
+        power *= UInt256(10);
+        text += '0';
+    }
+
+    test_round_trip(std::numeric_limits<UInt256>::max(),
+                    "115792089237316195423570985008687907853269984665640564039"
+                    "457584007913129639935");
+    test_round_trip(std::numeric_limits<Int256>::min(),
+                    "-57896044618658097711785492504343953926634992332820282019"
+                    "728792003956564819968");
+
+    const std::string too_large =
+        "115792089237316195423570985008687907853269984665640564039457584007913"
+        "129639936";
+    UInt256 value = 5;
+    const std::from_chars_result result = NicheLibrary::from_chars(
+        too_large.data(), too_large.data() + too_large.size(), value);
+    assert(result.ec == std::errc::result_out_of_range);
+    assert(value == UInt256(5));
+
+    std::stringstream invalid("12x");
+    invalid >> value;
+    assert(invalid.fail());
+}
+
+constexpr bool test_constexpr() {
+    const Int256 a = Int128::from_words(0x123456789abcdef0ULL, 42);
+    const Int256 b = -a * a;
+    return b / a == -a && b % a == 0 && Int256(-7) / Int256(2) == -3 &&
+           Int256(-7) % Int256(2) == -1 &&
+           static_cast<Int128>(b / a) == -Int128::from_words(
+                                                0x123456789abcdef0ULL, 42);
+}
+} // namespace
+
+int main() {
+    static_assert(test_constexpr(), "IntN must be constexpr.");
+    static_assert(std::numeric_limits<UInt256>::digits == 256,
+                  "UInt256 must have 256 value bits.");
+    static_assert(std::numeric_limits<UInt256>::digits10 == 77,
+                  "UInt256 must represent all 77-digit values.");
+    static_assert(std::numeric_limits<Int256>::digits == 255,
+                  "Int256 must have 255 value bits.");
+    static_assert(std::numeric_limits<NicheLibrary::UInt192>::digits10 == 57,
+                  "UInt192 must represent all 57-digit values.");
+    static_assert(std::numeric_limits<UIntN<2>>::digits10 ==
+                      std::numeric_limits<UInt128>::digits10,
+                  "UIntN<2> must match UInt128.");
+
+    test_two_words();
+    test_division_identity<3>();
+    test_division_identity<4>();
+    test_division_identity<6>();
+    test_io();
+
+    return 0;
+}
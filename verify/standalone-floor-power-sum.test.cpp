@@ -0,0 +1,125 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+#include "../internal/int128.hpp"
+#include "../math/number-theory/floor-power-sum.hpp"
+#include "../math/number-theory/generalized-floor-sum-degree-le-2.hpp"
+
+namespace {
+// 998244353 を法とする剰余環の型。Value として用いる。
+struct ModInt {
+    static constexpr std::uint64_t mod = 998244353;
+    std::uint64_t value = 0;
+
+    ModInt() = default;
+
+    template <class T> ModInt(T x) {
+        if constexpr (std::numeric_limits<T>::is_signed) {
+            const long long r = static_cast<long long>(x % T(mod));
+            value = static_cast<std::uint64_t>(r < 0 ? r + mod : r);
+        } else {
+            value = static_cast<std::uint64_t>(x % T(mod));
+        }
+    }
+
+    ModInt &operator+=(ModInt rhs) {
+        value = (value + rhs.value) % mod;
+        return *this;
+    }
+    ModInt &operator-=(ModInt rhs) {
+        value = (value + mod - rhs.value) % mod;
+        return *this;
+    }
+    ModInt &operator*=(ModInt rhs) {
+        value = value * rhs.value % mod;
+        return *this;
+    }
+    friend ModInt operator+(ModInt lhs, ModInt rhs) { return lhs += rhs; }
+    friend ModInt operator-(ModInt lhs, ModInt rhs) { return lhs -= rhs; }
+    friend ModInt operator*(ModInt lhs, ModInt rhs) { return lhs *= rhs; }
+    friend bool operator==(ModInt lhs, ModInt rhs) {
+        return lhs.value == rhs.value;
+    }
+};
+} // namespace
+
+int main() {
+    for (long long n = 0; n <= 15; ++n) {
+        for (long long m = 1; m <= 15; ++m) {
+            for (long long a = 0; a <= 20; ++a) {
+                for (long long b = 0; b <= 20; ++b) {
+                    const auto res =
+                        floor_power_sum<NicheLibrary::Int128, 3, 3>(n, m, a, b);
+                    for (int k1 = 0; k1 <= 3; ++k1) {
+                        for (int k2 = 0; k2 <= 3; ++k2) {
+                            long long expected = 0;
+                            for (long long i = 0; i < n; ++i) {
+                                long long term = 1;
+                                for (int k = 0; k < k1; ++k) {
+                                    term *= i;
+                                }
+                                const long long f = (a * i + b) / m;
+                                for (int k = 0; k < k2; ++k) {
+                                    term *= f;
+                                }
+                                expected += term;
+                            }
+                            assert(res[k1][k2] ==
+                                   NicheLibrary::Int128(expected));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    {
+        // 次数 2 以下の値は generalized_floor_sum_degree_le_2_modulo と一致する。
+        std::uint64_t state = 1;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        for (int i = 0; i < 10000; ++i) {
+            const long long n = static_cast<long long>(next() % (1ULL << 30));
+            const long long m =
+                static_cast<long long>(next() % (1ULL << 30)) + 1;
+            const long long a = static_cast<long long>(next() % (1ULL << 31));
+            const long long b = static_cast<long long>(next() % (1ULL << 31));
+            const auto res = floor_power_sum<ModInt, 4, 2>(n, m, a, b);
+            const auto expected =
+                generalized_floor_sum_degree_le_2_modulo<ModInt>(n, m, a, b);
+            assert(res[0][0] == ModInt(n));
+            assert(res[0][1] == expected.ans_01);
+            assert(res[1][1] == expected.ans_11);
+            assert(res[0][2] == expected.ans_02);
+
+            // floor を含まない項は Σ i、Σ i^2 である。
+            using NicheLibrary::Int128;
+            const Int128 mod(static_cast<long long>(ModInt::mod));
+            const Int128 sum_i = Int128(n) * Int128(n - 1) / Int128(2);
+            const Int128 sum_i2 = sum_i * Int128(2 * n - 1) / Int128(3);
+            assert(res[1][0] == ModInt(static_cast<long long>(sum_i % mod)));
+            assert(res[2][0] == ModInt(static_cast<long long>(sum_i2 % mod)));
+        }
+    }
+
+    {
+        // 定数式中でも評価できる。
+        // Σ_{i<10} i^k1 floor((7 i + 3) / 5)^k2 を直接計算した値と比べる。
+        constexpr auto res = floor_power_sum<long long, 2, 2>(10LL, 5LL, 7LL,
+                                                              3LL);
+        static_assert(res[0][0] == 10);
+        static_assert(res[0][1] == 65);
+        static_assert(res[1][1] == 408);
+        static_assert(res[0][2] == 585);
+        static_assert(res[2][2] == 31234);
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../math/number-theory/floor-sum-batch.hpp"
+#include "../math/number-theory/floor-sum.hpp"
+
+// Library Checker の sum_of_floor_of_linear と同じ制約の入力で、
+// floor_sum_batch が floor_sum と一致することを確かめる。
+// 制約: 1 <= T <= 10^5、1 <= n, m <= 10^9、0 <= a, b < m。
+
+int main() {
+    constexpr long long limit = 1000000000;
+    constexpr int T = 100000;
+    std::uint64_t state = 88172645463325252ULL;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    std::vector<long long> n(T), m(T), a(T), b(T);
+    for (int i = 0; i < T; ++i) {
+        // 小さい値と上限付近の値も含める。
+        const std::uint64_t kind = next() % 4;
+        const long long bound = kind == 0 ? 10 : limit;
+        n[i] = static_cast<long long>(next() % bound) + 1;
+        m[i] = static_cast<long long>(next() % bound) + 1;
+        if (kind == 1) {
+            n[i] = limit;
+            m[i] = limit - static_cast<long long>(next() % 3);
+        }
+        a[i] = static_cast<long long>(next() % m[i]);
+        b[i] = static_cast<long long>(next() % m[i]);
+    }
+
+    std::vector<long long> ans(T);
+    floor_sum_batch<long long>(n, m, a, b, ans);
+    for (int i = 0; i < T; ++i) {
+        assert(ans[i] == floor_sum<long long>(n[i], m[i], a[i], b[i]));
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "../math/number-theory/floor-sum-batch.hpp"
+#include "../math/number-theory/floor-sum.hpp"
+
+namespace {
+template <class T> struct Queries {
+    std::vector<T> n;
+    std::vector<T> m;
+    std::vector<T> a;
+    std::vector<T> b;
+
+    void push(T n_value, T m_value, T a_value, T b_value) {
+        n.push_back(n_value);
+        m.push_back(m_value);
+        a.push_back(a_value);
+        b.push_back(b_value);
+    }
+};
+
+// 中間計算が T に収まるよう、n を n_limit 以下、m を m_limit 以下、
+// |a|, |b| を m 程度に抑える。
+template <class T, class Next>
+Queries<T> random_queries(std::size_t size, std::uint64_t n_limit,
+                          std::uint64_t m_limit, Next &next) {
+    Queries<T> queries;
+    for (std::size_t i = 0; i < size; ++i) {
+        const T n = static_cast<T>(next() % (next() % n_limit + 1));
+        const T m = static_cast<T>(next() % (next() % m_limit + 1) + 1);
+        T a = static_cast<T>(next() % (2 * std::uint64_t(m)));
+        T b = static_cast<T>(next() % (2 * std::uint64_t(m)));
+        if constexpr (std::numeric_limits<T>::is_signed) {
+            a -= m;
+            b -= m;
+        }
+        if (next() % 8 == 0) {
+            a = m * static_cast<T>(next() % 3);
+        }
+        queries.push(n, m, a, b);
+    }
+    return queries;
+}
+
+template <class T>
+void check(const Queries<T> &queries, const std::vector<T> &out) {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        assert(out[i] == floor_sum(queries.n[i], queries.m[i], queries.a[i],
+                                   queries.b[i]));
+    }
+}
+
+template <class T> void test(std::uint64_t n_limit, std::uint64_t m_limit) {
+    std::uint64_t state = n_limit + m_limit;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (const std::size_t size : {0, 1, 5, 8, 9, 100, 20000}) {
+        const Queries<T> queries =
+            random_queries<T>(size, n_limit, m_limit, next);
+        std::vector<T> out(size);
+        floor_sum_batch<T>(queries.n, queries.m, queries.a, queries.b, out);
+        check(queries, out);
+
+        std::vector<T> parallel_out(size);
+        floor_sum_batch_parallel<T>(queries.n, queries.m, queries.a,
+                                    queries.b, parallel_out, 3);
+        assert(parallel_out == out);
+    }
+}
+} // namespace
+
+int main() {
+    test<int>(1 << 10, 1 << 10);
+    test<unsigned int>(1 << 10, 1 << 10);
+    test<long long>(1000000000, 1000000000);
+    test<std::uint64_t>(1000000000, 1000000000);
+    // m が 32 bit に収まらない場合。
+    test<long long>(1 << 20, 1LL << 40);
+    test<std::uint64_t>(1 << 20, 1ULL << 40);
+
+    return 0;
+}
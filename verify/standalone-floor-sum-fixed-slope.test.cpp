@@ -0,0 +1,80 @@
+// competitive-verifier: STANDALONE
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include "../internal/int128.hpp"
+#include "../math/number-theory/floor-sum-fixed-slope.hpp"
+#include "../math/number-theory/floor-sum.hpp"
+
+int main() {
+    for (long long m = 1; m <= 30; ++m) {
+        for (long long a = -40; a <= 40; ++a) {
+            const FloorSumFixedSlope<long long> fixed(m, a);
+            assert(fixed.m() == m);
+            for (long long n = 0; n <= 30; ++n) {
+                for (long long b = -40; b <= 40; ++b) {
+                    assert(fixed.sum(n, b) == floor_sum(n, m, a, b));
+                }
+            }
+        }
+    }
+
+    {
+        std::uint64_t state = 1;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        for (int i = 0; i < 2000; ++i) {
+            // a / m、b / m を小さくし、(m - 1)(n + 1) と答えが 64 bit に収まるようにする。
+            const int bits = static_cast<int>(next() % 60) + 1;
+            const long long m = static_cast<long long>(
+                (1ULL << (bits - 1)) + next() % (1ULL << (bits - 1)));
+            const long long a =
+                static_cast<long long>(next() % (1ULL << (bits + 1)));
+            const int n_bits = std::min(29, 61 - bits);
+            const FloorSumFixedSlope<long long> fixed(m, a);
+            const FloorSumFixedSlope<std::uint64_t> fixed_unsigned(
+                static_cast<std::uint64_t>(m), static_cast<std::uint64_t>(a));
+            const NicheLibrary::Int128 m_int128(m);
+            const NicheLibrary::Int128 a_int128(a);
+            const FloorSumFixedSlope<NicheLibrary::Int128> fixed_int128(
+                m_int128, a_int128);
+            for (int j = 0; j < 20; ++j) {
+                const long long n =
+                    static_cast<long long>(next() % (1ULL << n_bits));
+                const long long b =
+                    static_cast<long long>(next() % (1ULL << (bits + 2))) -
+                    (1LL << (bits + 1));
+                const long long expected = floor_sum(n, m, a, b);
+                assert(fixed.sum(n, b) == expected);
+                assert(fixed_int128.sum(NicheLibrary::Int128(n),
+                                        NicheLibrary::Int128(b)) ==
+                       NicheLibrary::Int128(expected));
+                if (b >= 0) {
+                    assert(fixed_unsigned.sum(static_cast<std::uint64_t>(n),
+                                              static_cast<std::uint64_t>(b)) ==
+                           floor_sum(static_cast<std::uint64_t>(n),
+                                     static_cast<std::uint64_t>(m),
+                                     static_cast<std::uint64_t>(a),
+                                     static_cast<std::uint64_t>(b)));
+                }
+            }
+        }
+    }
+
+    {
+        const FloorSumFixedSlope<int> fixed(7, 3);
+        for (int n = 0; n <= 100; ++n) {
+            for (int b = -50; b <= 50; ++b) {
+                assert(fixed.sum(n, b) == floor_sum(n, 7, 3, b));
+            }
+        }
+    }
+
+    return 0;
+}
@@ -1,11 +1,65 @@
 // competitive-verifier: STANDALONE
 
+#include <array>
 #include <cassert>
 #include <cstdint>
+#include <limits>
 
+#include "../internal/fixed-width-int.hpp"
 #include "../internal/int128.hpp"
 #include "../math/number-theory/floor-sum.hpp"
 
+// 998244353 を法とする剰余環の型。Mod として用いる。
+struct ModInt {
+    static constexpr std::uint64_t mod = 998244353;
+    std::uint64_t value = 0;
+
+    ModInt() = default;
+
+    template <class T> ModInt(T x) {
+        if constexpr (std::numeric_limits<T>::is_signed) {
+            const long long r = static_cast<long long>(x % T(mod));
+            value = static_cast<std::uint64_t>(r < 0 ? r + mod : r);
+        } else {
+            value = static_cast<std::uint64_t>(x % T(mod));
+        }
+    }
+
+    ModInt pow(std::uint64_t k) const {
+        ModInt result = 1;
+        ModInt base = *this;
+        for (; k > 0; k /= 2) {
+            if (k % 2 == 1) {
+                result *= base;
+            }
+            base *= base;
+        }
+        return result;
+    }
+
+    ModInt &operator+=(ModInt rhs) {
+        value = (value + rhs.value) % mod;
+        return *this;
+    }
+    ModInt &operator-=(ModInt rhs) {
+        value = (value + mod - rhs.value) % mod;
+        return *this;
+    }
+    ModInt &operator*=(ModInt rhs) {
+        value = value * rhs.value % mod;
+        return *this;
+    }
+    friend ModInt operator+(ModInt lhs, ModInt rhs) { return lhs += rhs; }
+    friend ModInt operator-(ModInt lhs, ModInt rhs) { return lhs -= rhs; }
+    friend ModInt operator*(ModInt lhs, ModInt rhs) { return lhs *= rhs; }
+    friend ModInt operator/(ModInt lhs, ModInt rhs) {
+        return lhs * rhs.pow(mod - 2);
+    }
+    friend bool operator==(ModInt lhs, ModInt rhs) {
+        return lhs.value == rhs.value;
+    }
+};
+
 long long floor_div_brute(long long x, long long m) {
     assert(m > 0);
 
@@ -25,6 +79,16 @@ long long floor_sum_brute(long long n, long long m, long long a, long long b) {
     return result;
 }
 
+constexpr long long floor_sum_brute_constexpr(long long n, long long m,
+                                              long long a, long long b) {
+    long long result = 0;
+    for (long long i = 0; i < n; ++i) {
+        const long long x = a * i + b;
+        result += x / m - (x % m < 0 ? 1 : 0);
+    }
+    return result;
+}
+
 int main() {
     for (long long n = 0; n <= 20; ++n) {
         for (long long m = 1; m <= 20; ++m) {
@@ -53,5 +117,75 @@ int main() {
         }
     }
 
+    {
+        // 答えが 64 bit に収まらない場合も、Mod で累積すれば T のままでよい。
+        using NicheLibrary::Int256;
+        std::uint64_t state = 1;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        for (int i = 0; i < 20000; ++i) {
+            const int bits = static_cast<int>(next() % 60) + 2;
+            const long long m =
+                static_cast<long long>(next() % (1ULL << (bits / 2))) + 1;
+            const long long n = static_cast<long long>(
+                next() % ((1ULL << (62 - bits / 2)) / (m + 1)));
+            const long long a =
+                static_cast<long long>(next() % (4 * m)) - 2 * m;
+            const long long b =
+                static_cast<long long>(next() % (4 * m)) - 2 * m;
+            const Int256 exact = floor_sum(Int256(n), Int256(m), Int256(a),
+                                           Int256(b));
+            const ModInt expected(static_cast<long long>(
+                exact % Int256(static_cast<long long>(ModInt::mod))));
+            assert((floor_sum_modulo<ModInt>(n, m, a, b) == expected));
+
+            const std::uint64_t un = static_cast<std::uint64_t>(n);
+            const std::uint64_t um = static_cast<std::uint64_t>(m);
+            const std::uint64_t ua = static_cast<std::uint64_t>(a + 2 * m);
+            const std::uint64_t ub = static_cast<std::uint64_t>(b + 2 * m);
+            const Int256 exact_unsigned =
+                floor_sum(Int256(un), Int256(um), Int256(ua), Int256(ub));
+            const ModInt expected_unsigned(static_cast<long long>(
+                exact_unsigned % Int256(static_cast<long long>(ModInt::mod))));
+            assert((floor_sum_modulo<ModInt>(un, um, ua, ub) ==
+                    expected_unsigned));
+        }
+    }
+
+    {
+        // 定数式中でも評価でき、表をコンパイル時に構築できる。
+        using NicheLibrary::Int128;
+        static_assert(floor_sum(10LL, 7LL, -5LL, 3LL) ==
+                      floor_sum_brute_constexpr(10, 7, -5, 3));
+        static_assert(floor_sum(1000000000LL, 998244353LL, 123456789LL,
+                                987654321LL) == 61836958798006594LL);
+        static_assert(floor_sum(Int128(30), Int128(11), Int128(-17),
+                                Int128(4)) ==
+                      Int128(floor_sum_brute_constexpr(30, 11, -17, 4)));
+
+        constexpr auto table = make_floor_sum_table<long long, 50>(7, -9, 5);
+        static_assert(table[0] == 0);
+        static_assert(table[49] == floor_sum(49LL, 7LL, -9LL, 5LL));
+        for (long long k = 0; k < 50; ++k) {
+            assert(table[k] == floor_sum_brute(k, 7, -9, 5));
+        }
+        for (long long m = 1; m <= 12; ++m) {
+            for (long long a = -15; a <= 15; ++a) {
+                for (long long b = -15; b <= 15; ++b) {
+                    const auto values =
+                        make_floor_sum_table<long long, 20>(m, a, b);
+                    for (long long k = 0; k < 20; ++k) {
+                        assert(values[k] == floor_sum_brute(k, m, a, b));
+                    }
+                }
+            }
+        }
+        static_assert(make_floor_sum_table<int, 0>(3, 1, 2).empty());
+    }
+
     return 0;
 }
@@ -2,9 +2,63 @@
 
 #include <cassert>
 #include <cstdint>
+#include <limits>
 
+#include "../internal/fixed-width-int.hpp"
+#include "../internal/int128.hpp"
 #include "../math/number-theory/generalized-floor-sum-degree-le-2.hpp"
 
+// 998244353 を法とする剰余環の型。Mod として用いる。
+struct ModInt {
+    static constexpr std::uint64_t mod = 998244353;
+    std::uint64_t value = 0;
+
+    ModInt() = default;
+
+    template <class T> ModInt(T x) {
+        if constexpr (std::numeric_limits<T>::is_signed) {
+            const long long r = static_cast<long long>(x % T(mod));
+            value = static_cast<std::uint64_t>(r < 0 ? r + mod : r);
+        } else {
+            value = static_cast<std::uint64_t>(x % T(mod));
+        }
+    }
+
+    ModInt pow(std::uint64_t k) const {
+        ModInt result = 1;
+        ModInt base = *this;
+        for (; k > 0; k /= 2) {
+            if (k % 2 == 1) {
+                result *= base;
+            }
+            base *= base;
+        }
+        return result;
+    }
+
+    ModInt &operator+=(ModInt rhs) {
+        value = (value + rhs.value) % mod;
+        return *this;
+    }
+    ModInt &operator-=(ModInt rhs) {
+        value = (value + mod - rhs.value) % mod;
+        return *this;
+    }
+    ModInt &operator*=(ModInt rhs) {
+        value = value * rhs.value % mod;
+        return *this;
+    }
+    friend ModInt operator+(ModInt lhs, ModInt rhs) { return lhs += rhs; }
+    friend ModInt operator-(ModInt lhs, ModInt rhs) { return lhs -= rhs; }
+    friend ModInt operator*(ModInt lhs, ModInt rhs) { return lhs *= rhs; }
+    friend ModInt operator/(ModInt lhs, ModInt rhs) {
+        return lhs * rhs.pow(mod - 2);
+    }
+    friend bool operator==(ModInt lhs, ModInt rhs) {
+        return lhs.value == rhs.value;
+    }
+};
+
 long long floor_div_brute(long long x, long long y) {
     assert(y > 0);
 
@@ -59,5 +113,172 @@ int main() {
         assert(ans == 202919340569980512ULL);
     }
 
+    {
+        // 既定の内部型では 64 bit で試して Int128 で計算し直すため、
+        // 桁あふれの有無によらず Int128 を指定した場合と一致する。
+        std::uint64_t state = 1;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        for (int i = 0; i < 20000; ++i) {
+            const int bits = static_cast<int>(next() % 61) + 1;
+            const long long limit = 1LL << bits;
+            const long long n = static_cast<long long>(next() % 1000000);
+            const long long m = static_cast<long long>(next() % limit) + 1;
+            const long long a =
+                static_cast<long long>(next() % (2 * limit)) - limit;
+            const long long b =
+                static_cast<long long>(next() % (2 * limit)) - limit;
+            const auto adaptive =
+                generalized_floor_sum_degree_le_2<long long>(n, m, a, b);
+            const auto wide =
+                generalized_floor_sum_degree_le_2<long long,
+                                                  NicheLibrary::Int128>(n, m,
+                                                                        a, b);
+            assert(adaptive.ans_01 == wide.ans_01);
+            assert(adaptive.ans_11 == wide.ans_11);
+            assert(adaptive.ans_02 == wide.ans_02);
+
+            using U = std::uint64_t;
+            const auto adaptive_unsigned = generalized_floor_sum_degree_le_2<U>(
+                U(n), U(m), U(a + limit), U(b + limit));
+            const auto wide_unsigned =
+                generalized_floor_sum_degree_le_2<U, NicheLibrary::Int128>(
+                    U(n), U(m), U(a + limit), U(b + limit));
+            assert(adaptive_unsigned.ans_01 == wide_unsigned.ans_01);
+            assert(adaptive_unsigned.ans_11 == wide_unsigned.ans_11);
+            assert(adaptive_unsigned.ans_02 == wide_unsigned.ans_02);
+        }
+    }
+
+    {
+        // 内部計算が Int128 に収まらない大きさの入力を Int256 で扱う。
+        using NicheLibrary::Int128;
+        using NicheLibrary::Int256;
+
+        const Int128 big = Int128::from_words(1, 0) * Int128(1000003);
+        const Int128 ns[] = {1, 2, 7, 100};
+        const Int128 ms[] = {1, 3, 1000000007, big + Int128(12345)};
+        const Int128 as[] = {0, -big, big * Int128(77), Int128(-12345)};
+        const Int128 bs[] = {0, big * Int128(-3), Int128(99), -big};
+        for (const Int128 n : ns) {
+            for (const Int128 m : ms) {
+                for (const Int128 a : as) {
+                    for (const Int128 b : bs) {
+                        Int256 s_01 = 0, s_11 = 0, s_02 = 0;
+                        for (Int128 i = 0; i < n; i += Int128(1)) {
+                            const Int256 x = Int256(a) * Int256(i) + Int256(b);
+                            Int256 value = x / Int256(m);
+                            if (value * Int256(m) > x) {
+                                value -= Int256(1);
+                            }
+                            s_01 += value;
+                            s_11 += Int256(i) * value;
+                            s_02 += value * value;
+                        }
+                        if (s_02 > Int256(std::numeric_limits<Int128>::max())) {
+                            continue;
+                        }
+
+                        const auto res =
+                            generalized_floor_sum_degree_le_2<Int128, Int256>(
+                                n, m, a, b);
+                        assert(Int256(res.ans_01) == s_01);
+                        assert(Int256(res.ans_11) == s_11);
+                        assert(Int256(res.ans_02) == s_02);
+                    }
+                }
+            }
+        }
+    }
+
+    {
+        // 答えが 64 bit に収まらない場合も、Mod で累積すれば T のままでよい。
+        using NicheLibrary::Int256;
+        std::uint64_t state = 2;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        const Int256 mod(static_cast<long long>(ModInt::mod));
+        auto to_mod = [&mod](const Int256 &value) {
+            return ModInt(static_cast<long long>(value % mod));
+        };
+        for (int i = 0; i < 20000; ++i) {
+            const int bits = static_cast<int>(next() % 60) + 2;
+            const long long m =
+                static_cast<long long>(next() % (1ULL << (bits / 2))) + 1;
+            const long long n = static_cast<long long>(
+                next() % ((1ULL << (62 - bits / 2)) / (m + 1)));
+            const long long a =
+                static_cast<long long>(next() % (4 * m)) - 2 * m;
+            const long long b =
+                static_cast<long long>(next() % (4 * m)) - 2 * m;
+            const auto exact = generalized_floor_sum_degree_le_2<Int256>(
+                Int256(n), Int256(m), Int256(a), Int256(b));
+            const auto res =
+                generalized_floor_sum_degree_le_2_modulo<ModInt>(n, m, a, b);
+            assert(res.ans_01 == to_mod(exact.ans_01));
+            assert(res.ans_11 == to_mod(exact.ans_11));
+            assert(res.ans_02 == to_mod(exact.ans_02));
+
+            // 法が偶数でもよい。std::uint64_t は 2^64 を法とする剰余環として扱える。
+            const auto res_2_64 =
+                generalized_floor_sum_degree_le_2_modulo<std::uint64_t>(n, m,
+                                                                        a, b);
+            assert(res_2_64.ans_01 == static_cast<std::uint64_t>(exact.ans_01));
+            assert(res_2_64.ans_11 == static_cast<std::uint64_t>(exact.ans_11));
+            assert(res_2_64.ans_02 == static_cast<std::uint64_t>(exact.ans_02));
+
+            using U = std::uint64_t;
+            const U un = static_cast<U>(n);
+            const U um = static_cast<U>(m);
+            const U ua = static_cast<U>(a + 2 * m);
+            const U ub = static_cast<U>(b + 2 * m);
+            const auto exact_unsigned =
+                generalized_floor_sum_degree_le_2<Int256>(
+                    Int256(un), Int256(um), Int256(ua), Int256(ub));
+            const auto res_unsigned =
+                generalized_floor_sum_degree_le_2_modulo<ModInt>(un, um, ua,
+                                                                 ub);
+            assert(res_unsigned.ans_01 == to_mod(exact_unsigned.ans_01));
+            assert(res_unsigned.ans_11 == to_mod(exact_unsigned.ans_11));
+            assert(res_unsigned.ans_02 == to_mod(exact_unsigned.ans_02));
+        }
+    }
+
+    {
+        // 定数式中では 64 bit での試行を行わず、既定の内部型で計算する。
+        constexpr auto res =
+            generalized_floor_sum_degree_le_2<long long>(20LL, 7LL, -5LL, 3LL);
+        static_assert(res.ans_01 == -136);
+        static_assert(res.ans_11 == -1770);
+        static_assert(res.ans_02 == 1270);
+        constexpr auto large = generalized_floor_sum_degree_le_2<std::uint64_t>(
+            900931385, 333006410, 263208878, 243209245);
+        static_assert(
+            large.ans_01 ==
+            generalized_floor_sum_degree_le_2<std::uint64_t,
+                                              NicheLibrary::Int256>(
+                900931385, 333006410, 263208878, 243209245)
+                .ans_01);
+        constexpr auto res_modulo =
+            generalized_floor_sum_degree_le_2_modulo<std::uint64_t>(
+                20LL, 7LL, -5LL, 3LL);
+        static_assert(res_modulo.ans_01 == static_cast<std::uint64_t>(-136));
+        static_assert(res_modulo.ans_11 == static_cast<std::uint64_t>(-1770));
+        static_assert(res_modulo.ans_02 == 1270);
+        const auto runtime =
+            generalized_floor_sum_degree_le_2<long long>(20, 7, -5, 3);
+        assert(runtime.ans_01 == res.ans_01);
+        assert(runtime.ans_11 == res.ans_11);
+        assert(runtime.ans_02 == res.ans_02);
+    }
+
     return 0;
 }
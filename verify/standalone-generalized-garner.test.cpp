@@ -2,8 +2,10 @@
 
 #include <cassert>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
+#include "../internal/fixed-width-int.hpp"
 #include "../internal/int128.hpp"
 #include "../math/number-theory/generalized-garner.hpp"
 
@@ -156,11 +158,285 @@ void self_test_int128() {
         assert(res.second == 0);
     }
 }
+void self_test_large_moduli() {
+    using i128 = NicheLibrary::Int128;
+    const long long moduli[] = {(1LL << 62) + 135, 4611686018427387847LL,
+                                999999999999999989LL, (1LL << 61) - 1,
+                                (1LL << 31) - 1};
+    const long long coefficients[] = {
+        1, 2, 3, 123456789, 987654321987654321LL, (1LL << 62) - 1};
+    for (const long long m : moduli) {
+        for (const long long a : coefficients) {
+            const long long b = (a % m) * 7 % m;
+            const auto res = generalized_garner<long long>(
+                std::vector<long long>{a}, std::vector<long long>{b},
+                std::vector<long long>{m});
+            assert(res.second > 0);
+            assert(res.first >= 0 && res.first < res.second);
+            assert(m % res.second == 0);
+            const i128 lhs = i128(a) * i128(res.first) - i128(b);
+            assert(lhs % i128(m) == 0);
+        }
+    }
+    {
+        const long long m0 = (1LL << 31) - 1;
+        const long long m1 = (1LL << 31) - 19;
+        const long long x0 = 3141592653589793238LL % (m0 * m1);
+        const auto res = generalized_garner<long long>(
+            std::vector<long long>{1, 1},
+            std::vector<long long>{x0 % m0, x0 % m1},
+            std::vector<long long>{m0, m1});
+        assert(res.first == x0);
+        assert(res.second == m0 * m1);
+    }
+}
+
+void self_test_wide_moduli() {
+    // Int128 は前計算した除算器による剰余乗算、Int256 は加算と 2 倍による剰余乗算を用いる。
+    using i128 = NicheLibrary::Int128;
+    using i256 = NicheLibrary::Int256;
+    std::uint64_t state = 7;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    auto random_below = [&next](int bits) {
+        const std::uint64_t high =
+            bits > 64 ? next() >> (128 - bits) : std::uint64_t{0};
+        const std::uint64_t low = bits >= 64 ? next() : next() >> (64 - bits);
+        return i128::from_words(high, low);
+    };
+    for (int iter = 0; iter < 3000; ++iter) {
+        const int count = static_cast<int>(next() % 3) + 1;
+        const int bits = 120 / count;
+        std::vector<i128> a;
+        std::vector<i128> b;
+        std::vector<i128> m;
+        std::vector<i256> a_wide;
+        std::vector<i256> b_wide;
+        std::vector<i256> m_wide;
+        for (int i = 0; i < count; ++i) {
+            const i128 mi = random_below(bits) + i128(1);
+            const i128 ai = random_below(bits);
+            const i128 bi = random_below(bits);
+            a.push_back(ai);
+            b.push_back(bi);
+            m.push_back(mi);
+            a_wide.push_back(i256(ai));
+            b_wide.push_back(i256(bi));
+            m_wide.push_back(i256(mi));
+        }
+        const auto res = generalized_garner<i128>(a, b, m);
+        const auto expected = generalized_garner<i256>(a_wide, b_wide, m_wide);
+        assert(i256(res.first) == expected.first);
+        assert(i256(res.second) == expected.second);
+    }
+}
+
+void self_test_lehmer() {
+    // Int128 と UInt128 の gcd と inv_mod は Lehmer の方法を用いる。
+    // gcd は UInt256 での通常の互除法と、逆元は UInt256 での積と比べる。
+    namespace gg_internal = generalized_garner_internal;
+    using u128 = NicheLibrary::UInt128;
+    using i128 = NicheLibrary::Int128;
+    using u256 = NicheLibrary::UInt256;
+    std::uint64_t state = 3;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    auto random_below = [&next](int bits) {
+        const std::uint64_t high =
+            bits > 64 ? next() >> (128 - bits) : std::uint64_t{0};
+        const std::uint64_t low = bits >= 64 ? next() : next() >> (64 - bits);
+        return u128::from_words(high, low);
+    };
+    auto check_pair = [](u128 x, u128 y) {
+        const u256 want = gg_internal::gcd(u256(x), u256(y));
+        const u128 g = gg_internal::gcd(x, y);
+        assert(u256(g) == want);
+        assert(gg_internal::gcd(y, x) == g);
+        const u128 signed_max = u128::from_words(~std::uint64_t{0} >> 1,
+                                                 ~std::uint64_t{0});
+        if (x <= signed_max && y <= signed_max) {
+            const i128 sx = i128::from_words(x.high(), x.low());
+            const i128 sy = i128::from_words(y.high(), y.low());
+            assert(gg_internal::gcd(sx, sy) ==
+                   i128::from_words(g.high(), g.low()));
+        }
+        if (x > y && y != 0 && g == 1) {
+            const gg_internal::ModMultiplier<u128> multiplier(x);
+            const u128 inv = gg_internal::inv_mod(y, multiplier);
+            assert(inv < x);
+            assert(u256(inv) * u256(y) % u256(x) == u256(1));
+            if (x <= signed_max) {
+                const gg_internal::ModMultiplier<i128> signed_multiplier(
+                    i128::from_words(x.high(), x.low()));
+                assert(gg_internal::inv_mod(
+                           i128::from_words(y.high(), y.low()),
+                           signed_multiplier) ==
+                       i128::from_words(inv.high(), inv.low()));
+            }
+        }
+    };
+
+    const u128 max = u128::from_words(~std::uint64_t{0}, ~std::uint64_t{0});
+    for (int iter = 0; iter < 20000; ++iter) {
+        const int x_bits = static_cast<int>(next() % 128) + 1;
+        const int y_bits = static_cast<int>(next() % 128) + 1;
+        check_pair(random_below(x_bits), random_below(y_bits));
+        // 共通の大きな因数を持つ組と、一方が他方の倍数である組。
+        const u128 g = random_below(64) + u128(1);
+        const u128 x = random_below(60);
+        const u128 y = random_below(60);
+        check_pair(g * x, g * y);
+        check_pair(g * x, g);
+    }
+    // 連続する Fibonacci 数は商が全て 1 になる。
+    u128 f0 = 1;
+    u128 f1 = 1;
+    while (f1 <= max - f0) {
+        f0 = std::exchange(f1, f0 + f1);
+        check_pair(f1, f0);
+    }
+    for (std::uint64_t low = 0; low < 64; ++low) {
+        check_pair(max, u128(low));
+        check_pair(max - u128(low), max);
+        check_pair(u128::from_words(1, low), u128::from_words(1, 0));
+        check_pair(u128::from_words(low, 0), u128::from_words(0, low + 1));
+    }
+}
+
+void self_test_accumulator() {
+    // 式を 1 つずつ加えたときの解は、それまでの式に generalized_garner を適用した結果と一致する。
+    std::uint64_t state = 1;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int iter = 0; iter < 2000; ++iter) {
+        GarnerAccumulator<long long> accumulator;
+        std::vector<long long> a;
+        std::vector<long long> b;
+        std::vector<long long> m;
+        assert(accumulator.current() == std::make_pair(0LL, 1LL));
+        const int count = static_cast<int>(next() % 8);
+        for (int i = 0; i < count; ++i) {
+            // 解が残りやすいように、法を小さな数の積にする。
+            const long long mi = static_cast<long long>(next() % 12) + 1;
+            const long long ai = static_cast<long long>(next() % 25) - 12;
+            const long long bi = static_cast<long long>(next() % 25) - 12;
+            a.push_back(ai);
+            b.push_back(bi);
+            m.push_back(mi);
+            const bool ok = accumulator.push(ai, bi, mi);
+            const auto expected = generalized_garner<long long>(a, b, m);
+            assert(accumulator.current() == expected);
+            assert(ok == (expected.second != 0));
+            assert(accumulator.satisfiable() == ok);
+            assert(accumulator.size() == a.size());
+        }
+    }
+
+    {
+        GarnerAccumulator<long long> accumulator;
+        assert(accumulator.push(1, 2, 3));
+        const auto snapshot = accumulator.snapshot();
+        assert(accumulator.push(1, 3, 5));
+        assert(accumulator.current() == std::make_pair(8LL, 15LL));
+        accumulator.rollback(snapshot);
+        assert(accumulator.current() == std::make_pair(2LL, 3LL));
+        assert(accumulator.size() == 1);
+
+        // 解がなくなった後の式は無視されるが、巻き戻すと再び式を加えられる。
+        assert(!accumulator.push(1, 0, 6));
+        assert(!accumulator.push(1, 0, 1));
+        assert(accumulator.current() == std::make_pair(0LL, 0LL));
+        assert(accumulator.size() == 3);
+        accumulator.rollback(snapshot);
+        assert(accumulator.push(2, 1, 7));
+        assert(accumulator.current() == std::make_pair(11LL, 21LL));
+    }
+
+    {
+        // 大きな法でも 1 回の push は 1 回の合成で済む。
+        const long long m0 = (1LL << 31) - 1;
+        const long long m1 = (1LL << 31) - 19;
+        const long long x0 = 3141592653589793238LL % (m0 * m1);
+        GarnerAccumulator<NicheLibrary::Int128> accumulator;
+        assert(accumulator.push(1, x0 % m0, m0));
+        assert(accumulator.push(1, x0 % m1, m1));
+        const auto [r, mod] = accumulator.current();
+        assert(r == NicheLibrary::Int128(x0));
+        assert(mod == NicheLibrary::Int128(m0) * NicheLibrary::Int128(m1));
+    }
+}
+
+void self_test_product_tree() {
+    // 二分木に沿って合成しても、順に合成した場合と同じ結果になる。
+    std::uint64_t state = 5;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    // 法を L = 2^6 3^4 5^2 7^2 11 13 の約数とし、x0 を解に持つ式を並べる。
+    const long long l = 64LL * 81 * 25 * 49 * 11 * 13;
+    std::vector<long long> divisors;
+    for (long long d = 1; d <= l; ++d) {
+        if (l % d == 0) {
+            divisors.push_back(d);
+        }
+    }
+    for (int iter = 0; iter < 200; ++iter) {
+        const std::size_t n = iter < 100 ? next() % 300 : next() % 5000;
+        const long long x0 = static_cast<long long>(next() % l);
+        std::vector<long long> a(n);
+        std::vector<long long> b(n);
+        std::vector<long long> m(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            m[i] = divisors[next() % divisors.size()];
+            a[i] = static_cast<long long>(next() % 1000) - 500;
+            b[i] = safe_mod_ll(a[i] * x0, m[i]);
+        }
+        if (iter % 4 == 3 && n > 0) {
+            // 矛盾する式を 1 つ混ぜる。
+            const std::size_t i = next() % n;
+            m[i] = 2;
+            a[i] = 0;
+            b[i] = 1;
+        }
+        const auto expected = generalized_garner<long long>(a, b, m);
+        for (const unsigned thread_count : {1U, 3U, 8U}) {
+            assert((generalized_garner_product_tree<long long>(
+                        a, b, m, thread_count) == expected));
+        }
+        if (iter % 4 != 3 && n > 0) {
+            assert(safe_mod_ll(x0, expected.second) == expected.first);
+        }
+    }
+    const auto empty = generalized_garner_product_tree<long long>(
+        std::vector<long long>{}, std::vector<long long>{},
+        std::vector<long long>{});
+    assert(empty.first == 0 && empty.second == 1);
+}
 } // namespace
 
 int main() {
     self_test_small();
     self_test_int128();
+    self_test_large_moduli();
+    self_test_wide_moduli();
+    self_test_lehmer();
+    self_test_accumulator();
+    self_test_product_tree();
 
     return 0;
 }
@@ -0,0 +1,111 @@
+// competitive-verifier: STANDALONE
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "../internal/int128-radix-sort.hpp"
+#include "../internal/int128.hpp"
+
+namespace {
+using NicheLibrary::Int128;
+using NicheLibrary::UInt128;
+
+template <class Next>
+std::vector<UInt128> random_values(std::size_t size, int mode, Next &next) {
+    std::vector<UInt128> values(size);
+    for (UInt128 &value : values) {
+        const std::uint64_t high = next();
+        const std::uint64_t low = next();
+        if (mode == 0) {
+            value = UInt128::from_words(high, low);
+        } else if (mode == 1) {
+            // 上位の語が少数の値しかとらず、多くの桁が共通になる。
+            value = UInt128::from_words(high % 3, low);
+        } else if (mode == 2) {
+            value = UInt128::from_words(high, low % 5);
+        } else {
+            value = UInt128::from_words(~std::uint64_t{} * (high % 2),
+                                        low % 1000);
+        }
+    }
+    return values;
+}
+
+template <class Next>
+void test_unsigned(std::size_t size, int mode, Next &next) {
+    std::vector<UInt128> values = random_values(size, mode, next);
+    std::vector<UInt128> expected = values;
+    std::sort(expected.begin(), expected.end());
+    NicheLibrary::radix_sort(values);
+    assert(values == expected);
+}
+
+template <class Next>
+void test_signed(std::size_t size, int mode, Next &next) {
+    const std::vector<UInt128> bits = random_values(size, mode, next);
+    std::vector<Int128> values(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        values[i] = Int128::from_words(bits[i].high(), bits[i].low());
+    }
+    std::vector<Int128> expected = values;
+    std::sort(expected.begin(), expected.end());
+    NicheLibrary::radix_sort(values);
+    assert(values == expected);
+}
+
+void test_hash() {
+    std::unordered_set<UInt128> unsigned_set;
+    std::unordered_set<Int128> signed_set;
+    for (int i = 0; i < 1000; ++i) {
+        const UInt128 value = UInt128::from_words(i % 4, i / 4 % 4);
+        unsigned_set.insert(value);
+        signed_set.insert(Int128::from_words(value.high(), value.low()));
+    }
+    assert(unsigned_set.size() == 16);
+    assert(signed_set.size() == 16);
+    assert(unsigned_set.count(UInt128::from_words(3, 3)) == 1);
+    assert(signed_set.count(Int128(-1)) == 0);
+
+    // 上位と下位の語を入れ替えた値や、1 bit だけ異なる値の衝突がない。
+    std::unordered_set<std::size_t> hashes;
+    const std::hash<UInt128> hasher;
+    for (int i = 0; i < 64; ++i) {
+        hashes.insert(hasher(UInt128::from_words(0, std::uint64_t{1} << i)));
+        hashes.insert(hasher(UInt128::from_words(std::uint64_t{1} << i, 0)));
+    }
+    assert(hashes.size() == 128);
+    assert(std::hash<Int128>{}(Int128(-5)) ==
+           hasher(UInt128::from_words(~std::uint64_t{}, -5ULL)));
+}
+} // namespace
+
+int main() {
+    std::uint64_t state = 1;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (const std::size_t size : {0, 1, 2, 10, 63, 64, 65, 1000, 20000}) {
+        for (int mode = 0; mode < 4; ++mode) {
+            test_unsigned(size, mode, next);
+            test_signed(size, mode, next);
+        }
+    }
+
+    {
+        std::vector<Int128> values(1000, Int128(-3));
+        NicheLibrary::radix_sort(values);
+        assert(std::all_of(values.begin(), values.end(),
+                           [](Int128 value) { return value == Int128(-3); }));
+    }
+
+    test_hash();
+
+    return 0;
+}
@@ -1,9 +1,15 @@
 // competitive-verifier: STANDALONE
 
+#include <array>
 #include <cassert>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
 
 #include "../internal/int128.hpp"
 
@@ -146,6 +152,186 @@ constexpr bool test_uint128_div_mod_fast_paths() {
     UInt128::div_mod(smaller, larger, quotient, remainder);
     return quotient == UInt128{} && remainder == smaller;
 }
+
+constexpr std::array<UInt128, 10> backend_sample_values = {
+    UInt128(0),
+    UInt128(1),
+    UInt128(3),
+    UInt128::from_words(0, (std::uint64_t{1} << 32) + 1),
+    UInt128::from_words(0, ~std::uint64_t{}),
+    UInt128::from_words(1, 1),
+    UInt128::from_words(0x123456789abcdef0ULL, 0xfedcba9876543210ULL),
+    UInt128::from_words(0xfedcba9876543210ULL, 0x123456789abcdef0ULL),
+    UInt128::from_words(std::uint64_t{1} << 63, 0),
+    UInt128::from_words(~std::uint64_t{}, ~std::uint64_t{}),
+};
+
+constexpr std::size_t backend_sample_count = backend_sample_values.size();
+
+struct BackendSample {
+    UInt128 product;
+    UInt128 quotient;
+    UInt128 remainder;
+    Int128 signed_quotient;
+    Int128 signed_remainder;
+};
+
+// 定数式の評価では GCC 拡張を用いない実装が、実行時には unsigned __int128
+// による実装が（使える場合は）使われる。
+constexpr std::array<BackendSample, backend_sample_count * backend_sample_count>
+make_backend_samples() {
+    std::array<BackendSample, backend_sample_count * backend_sample_count>
+        samples{};
+    for (std::size_t i = 0; i < backend_sample_count; ++i) {
+        for (std::size_t j = 0; j < backend_sample_count; ++j) {
+            const UInt128 lhs = backend_sample_values[i];
+            const UInt128 rhs = backend_sample_values[j];
+            BackendSample &sample = samples[i * backend_sample_count + j];
+            sample.product = lhs * rhs;
+            if (rhs == UInt128{}) {
+                continue;
+            }
+            UInt128::div_mod(lhs, rhs, sample.quotient, sample.remainder);
+            const Int128 signed_lhs = Int128::from_words(lhs.high(), lhs.low());
+            const Int128 signed_rhs = Int128::from_words(rhs.high(), rhs.low());
+            if (signed_lhs == std::numeric_limits<Int128>::min() &&
+                signed_rhs == Int128(-1)) {
+                continue;
+            }
+            Int128::div_mod(signed_lhs, signed_rhs, sample.signed_quotient,
+                            sample.signed_remainder);
+        }
+    }
+    return samples;
+}
+
+void test_backend_consistency() {
+    constexpr auto expected = make_backend_samples();
+    const auto actual = make_backend_samples();
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        assert(actual[i].product == expected[i].product);
+        assert(actual[i].quotient == expected[i].quotient);
+        assert(actual[i].remainder == expected[i].remainder);
+        assert(actual[i].signed_quotient == expected[i].signed_quotient);
+        assert(actual[i].signed_remainder == expected[i].signed_remainder);
+    }
+}
+
+template <class T> void test_round_trip(T value) {
+    char buffer[40];
+    const std::to_chars_result written =
+        NicheLibrary::to_chars(buffer, buffer + 40, value);
+    assert(written.ec == std::errc{});
+
+    std::stringstream stream;
+    stream << value;
+    assert(stream.str() == std::string(buffer, written.ptr));
+
+    T parsed;
+    const std::from_chars_result read =
+        NicheLibrary::from_chars(buffer, written.ptr, parsed);
+    assert(read.ec == std::errc{});
+    assert(read.ptr == written.ptr);
+    assert(parsed == value);
+
+    char small[1];
+    if (written.ptr - buffer > 1) {
+        assert(NicheLibrary::to_chars(small, small + 1, value).ec ==
+               std::errc::value_too_large);
+    }
+}
+
+template <class T>
+void test_from_chars_error(const std::string &text, std::errc ec,
+                           std::size_t consumed) {
+    T value = 7;
+    const std::from_chars_result result = NicheLibrary::from_chars(
+        text.data(), text.data() + text.size(), value);
+    assert(result.ec == ec);
+    assert(result.ptr == text.data() + consumed);
+    assert(value == T(7));
+}
+
+void test_charconv() {
+    UInt128 power = 1;
+    for (int i = 0; i <= 38; ++i) {
+        test_round_trip(power);
+        test_round_trip(power - UInt128(1));
+        test_round_trip(power + UInt128(1));
+        test_round_trip(Int128::from_words(power.high(), power.low()));
+        test_round_trip(-Int128::from_words(power.high(), power.low()));
+        power *= UInt128(10);
+    }
+    test_round_trip(std::numeric_limits<UInt128>::max());
+    test_round_trip(std::numeric_limits<Int128>::max());
+    test_round_trip(std::numeric_limits<Int128>::min());
+
+    {
+        const std::string text = "000000000000000000000000000000000000000000"
+                                 "0012345678901234567890x";
+        UInt128 value;
+        const std::from_chars_result result = NicheLibrary::from_chars(
+            text.data(), text.data() + text.size(), value);
+        assert(result.ec == std::errc{});
+        assert(*result.ptr == 'x');
+        assert(value == UInt128::multiply_u64(1234567890, 10000000000ULL) +
+                            UInt128(1234567890));
+    }
+
+    test_from_chars_error<UInt128>("", std::errc::invalid_argument, 0);
+    test_from_chars_error<UInt128>("-1", std::errc::invalid_argument, 0);
+    test_from_chars_error<UInt128>("+1", std::errc::invalid_argument, 0);
+    test_from_chars_error<Int128>("-", std::errc::invalid_argument, 0);
+    test_from_chars_error<Int128>("-x", std::errc::invalid_argument, 0);
+    test_from_chars_error<UInt128>("340282366920938463463374607431768211456",
+                                   std::errc::result_out_of_range, 39);
+    test_from_chars_error<UInt128>("400000000000000000000000000000000000000",
+                                   std::errc::result_out_of_range, 39);
+    test_from_chars_error<UInt128>("1000000000000000000000000000000000000000",
+                                   std::errc::result_out_of_range, 40);
+    test_from_chars_error<Int128>("170141183460469231731687303715884105728",
+                                  std::errc::result_out_of_range, 39);
+    test_from_chars_error<Int128>("-170141183460469231731687303715884105729",
+                                  std::errc::result_out_of_range, 40);
+
+    {
+        const std::string text =
+            " 12\n-34\t\t170141183460469231731687303715884105727 0 ";
+        std::vector<Int128> values;
+        const std::from_chars_result result =
+            NicheLibrary::parse_int128_sequence(
+                text.data(), text.data() + text.size(), values);
+        assert(result.ec == std::errc{});
+        assert(result.ptr == text.data() + text.size());
+        assert(values.size() == 4);
+        assert(values[0] == Int128(12));
+        assert(values[1] == Int128(-34));
+        assert(values[2] == std::numeric_limits<Int128>::max());
+        assert(values[3] == Int128(0));
+    }
+
+    {
+        const std::string text = "1 2 3x 4";
+        std::vector<UInt128> values;
+        const std::from_chars_result result =
+            NicheLibrary::parse_uint128_sequence(
+                text.data(), text.data() + text.size(), values);
+        assert(result.ec == std::errc::invalid_argument);
+        assert(result.ptr == text.data() + 5);
+        assert(values.size() == 2);
+    }
+
+    {
+        std::stringstream stream("+5 -3 abc");
+        Int128 a;
+        Int128 b;
+        Int128 c = 9;
+        stream >> a >> b;
+        assert(a == Int128(5) && b == Int128(-3));
+        stream >> c;
+        assert(stream.fail() && c == Int128(9));
+    }
+}
 } // namespace
 
 int main() {
@@ -229,6 +415,8 @@ int main() {
         }
     }
 
+    test_backend_consistency();
+
     {
         std::stringstream stream;
         stream << UInt128::from_words(~std::uint64_t{}, ~std::uint64_t{});
@@ -255,5 +443,7 @@ int main() {
         assert(value == std::numeric_limits<UInt128>::max());
     }
 
+    test_charconv();
+
     return 0;
 }
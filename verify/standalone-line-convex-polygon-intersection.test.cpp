@@ -3,9 +3,11 @@
 #include <cassert>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <vector>
 
 #include "../geometry/line-convex-polygon-intersection.hpp"
+#include "../internal/fixed-width-int.hpp"
 
 int main() {
     using Point = std::complex<long long>;
@@ -95,5 +97,71 @@ int main() {
         assert(std::abs(real_point.imag() - 1.75L) < 1e-15L);
     }
 
+    {
+        // 既定では 64 bit で試して Int128 で計算し直すため、
+        // 座標の大きさによらず Int128 を指定した場合と一致する。
+        std::uint64_t state = 1;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        const long long shape[][2] = {{1, 0}, {2, 0}, {3, 1}, {3, 2},
+                                      {2, 3}, {1, 3}, {0, 2}, {0, 1}};
+        for (int bits = 0; bits <= 58; bits += 2) {
+            const long long scale = 1LL << bits;
+            std::vector<Point> hull;
+            for (const auto &vertex : shape) {
+                hull.emplace_back(vertex[0] * scale, vertex[1] * scale);
+            }
+            auto random_coordinate = [&]() {
+                return static_cast<long long>(next() % 5) * scale -
+                       scale / 2 + static_cast<long long>(next() % 7);
+            };
+            for (int i = 0; i < 200; ++i) {
+                const Point line_a(random_coordinate(), random_coordinate());
+                const Point line_b(random_coordinate(), random_coordinate());
+                if (line_a == line_b) {
+                    continue;
+                }
+                const auto adaptive =
+                    line_convex_hull_intersection(hull, line_a, line_b);
+                const auto wide = line_convex_hull_intersection<Point, Int128>(
+                    hull, line_a, line_b);
+                assert(adaptive == wide);
+            }
+        }
+    }
+
+    {
+        // 座標が 2^62 程度の場合、交点の分子は Int128 に収まらない。
+        using NicheLibrary::Int256;
+        const long long l = 1LL << 62;
+        std::vector<Point> hull = {Point(0, 0), Point(l, 0), Point(l, l),
+                                   Point(0, l)};
+        const Point line_a(l / 3, -l + 7);
+        const Point line_b(l - 5, l - 11);
+        const auto result =
+            line_convex_hull_intersection<Point, Int256>(hull, line_a, line_b);
+
+        assert(result.size() == 2);
+        const Int256 ax = line_a.real();
+        const Int256 ay = line_a.imag();
+        const Int256 dx = Int256(line_b.real()) - ax;
+        const Int256 dy = Int256(line_b.imag()) - ay;
+        for (const auto &point : result) {
+            assert(point.denominator > 0);
+            assert((point.x_numerator - ax * point.denominator) * dy ==
+                   (point.y_numerator - ay * point.denominator) * dx);
+            assert(point.x_numerator >= 0 &&
+                   point.x_numerator <= Int256(l) * point.denominator);
+            assert(point.y_numerator >= 0 &&
+                   point.y_numerator <= Int256(l) * point.denominator);
+            const long double x = point.template x_as<long double>();
+            assert(0 <= x && x <= static_cast<long double>(l));
+        }
+    }
+
     return 0;
 }
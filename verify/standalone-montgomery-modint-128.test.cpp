@@ -0,0 +1,146 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../internal/int128.hpp"
+#include "../math/modint/montgomery-modint-128.hpp"
+
+namespace {
+using NicheLibrary::Int128;
+using NicheLibrary::UInt128;
+
+UInt128 add_mod_naive(UInt128 a, UInt128 b, UInt128 mod) {
+    if (a >= mod - b) {
+        return a - (mod - b);
+    }
+    return a + b;
+}
+
+UInt128 mul_mod_naive(UInt128 a, UInt128 b, UInt128 mod) {
+    UInt128 result = 0;
+    a %= mod;
+    while (b != UInt128{}) {
+        if (b.low() % 2 == 1) {
+            result = add_mod_naive(result, a, mod);
+        }
+        a = add_mod_naive(a, a, mod);
+        b /= UInt128(2);
+    }
+    return result;
+}
+
+template <class ModInt> void check_random(std::uint64_t seed) {
+    const UInt128 mod = ModInt::mod();
+    auto check = [&mod](UInt128 a, UInt128 b) {
+        const ModInt x = a;
+        const ModInt y = b;
+        assert(x.val() == a);
+        assert((x + y).val() == add_mod_naive(a, b, mod));
+        assert((x - y + y).val() == a);
+        assert((-x + x).val() == UInt128{});
+        assert((x * y).val() == mul_mod_naive(a, b, mod));
+    };
+    const std::vector<UInt128> edges = {UInt128(0), UInt128(1) % mod,
+                                        mod - UInt128(1), mod / UInt128(2)};
+    for (const UInt128 a : edges) {
+        for (const UInt128 b : edges) {
+            check(a, b);
+        }
+    }
+    std::uint64_t state = seed;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 2000; ++i) {
+        check(UInt128::from_words(next(), next()) % mod,
+              UInt128::from_words(next(), next()) % mod);
+    }
+}
+
+template <class ModInt> void check_prime_field() {
+    const UInt128 mod = ModInt::mod();
+    std::uint64_t state = 777;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 200; ++i) {
+        const ModInt x =
+            UInt128::from_words(next(), next());
+        if (x == ModInt(0)) {
+            continue;
+        }
+        assert((x * x.inv()).val() == UInt128(1));
+        assert((x / x).val() == UInt128(1));
+        assert(x.pow(mod - UInt128(1)).val() == UInt128(1));
+        assert(x.pow(mod) == x);
+    }
+}
+
+constexpr bool test_constexpr() {
+    using ModInt = StaticMontgomeryModInt128<0, 1000000007>;
+    const ModInt x = 123456789;
+    const ModInt y = -5;
+    return (x * y).val() == UInt128(123456789ULL * (1000000007ULL - 5) %
+                                    1000000007ULL) &&
+           (x * x.inv()).val() == UInt128(1);
+}
+} // namespace
+
+int main() {
+    static_assert(test_constexpr(), "MontgomeryModInt128 must be constexpr.");
+
+    // 2^127 - 1
+    using Mersenne127 =
+        StaticMontgomeryModInt128<0x7fffffffffffffffULL, 0xffffffffffffffffULL>;
+    check_random<Mersenne127>(1);
+    check_prime_field<Mersenne127>();
+    assert(Mersenne127(-1).val() == Mersenne127::mod() - UInt128(1));
+    assert(Mersenne127(Int128(-3)).val() == Mersenne127::mod() - UInt128(3));
+    assert(Mersenne127(2).pow(UInt128(127)).val() == UInt128(1));
+
+    using Small = StaticMontgomeryModInt128<0, 998244353>;
+    check_random<Small>(2);
+    check_prime_field<Small>();
+
+    using Dynamic = DynamicMontgomeryModInt128<0>;
+    std::vector<UInt128> mods = {
+        UInt128(1),
+        UInt128(3),
+        UInt128::from_words(0, ~std::uint64_t{}),
+        UInt128::from_words(1, 1),
+        UInt128::from_words(std::uint64_t{1} << 56, 0x123456789abcdef1ULL),
+        UInt128::from_words(~std::uint64_t{}, ~std::uint64_t{}),
+        UInt128::from_words(~std::uint64_t{}, ~std::uint64_t{} - 58),
+    };
+    std::uint64_t state = 31415;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 20; ++i) {
+        const std::uint64_t high = next() >> (i % 64);
+        mods.push_back(UInt128::from_words(high, next() | 1));
+    }
+    for (const UInt128 mod : mods) {
+        Dynamic::set_mod(mod);
+        assert(Dynamic::mod() == mod);
+        check_random<Dynamic>(mod.low());
+    }
+
+    // 2^128 - 159 は素数。
+    Dynamic::set_mod(
+        UInt128::from_words(~std::uint64_t{}, ~std::uint64_t{} - 158));
+    check_prime_field<Dynamic>();
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../math/multiplicative-function/multiplicative-prefix-sum.hpp"
+
+namespace {
+// f(p) = f_prime[p mod m]、f(p^e) = power_base[p mod 5] + e * p (e >= 2) とする。
+// 積は 2^64 を法として扱う。
+struct Function {
+    long long m;
+    std::vector<std::uint64_t> f_prime;
+    std::vector<std::uint64_t> power_base;
+
+    std::uint64_t prime_power(long long p, long long e) const {
+        return power_base[p % 5] + static_cast<std::uint64_t>(e * p);
+    }
+
+    // f(1), ..., f(N) を素因数分解により求める。
+    std::vector<std::uint64_t> values(long long N) const {
+        std::vector<std::uint64_t> res(N + 1, 1);
+        std::vector<long long> rest(N + 1);
+        for (long long n = 0; n <= N; ++n) {
+            rest[n] = n;
+        }
+        for (long long p = 2; p <= N; ++p) {
+            if (rest[p] != p) {
+                continue;
+            }
+            for (long long n = p; n <= N; n += p) {
+                long long e = 0;
+                while (rest[n] % p == 0) {
+                    rest[n] /= p;
+                    ++e;
+                }
+                res[n] *= e == 1 ? f_prime[p % m] : prime_power(p, e);
+            }
+        }
+        return res;
+    }
+};
+
+template <class Next> Function random_function(long long m, Next &next) {
+    Function f{m, std::vector<std::uint64_t>(m), std::vector<std::uint64_t>(5)};
+    for (auto &value : f.f_prime) {
+        value = next() % 7;
+    }
+    for (auto &value : f.power_base) {
+        value = next() % 5;
+    }
+    return f;
+}
+
+void self_test_small() {
+    std::uint64_t state = 1;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (long long m = 1; m <= 12; ++m) {
+        const Function f = random_function(m, next);
+        const auto values = f.values(600);
+        auto prime_power = [&f](long long p, long long e) {
+            return f.prime_power(p, e);
+        };
+        std::uint64_t naive = 0;
+        for (long long N = 0; N <= 600; ++N) {
+            if (N >= 1) {
+                naive += values[N];
+            }
+            assert(multiplicative_prefix_sum(N, m, f.f_prime, prime_power) ==
+                   naive);
+            const auto table =
+                multiplicative_prefix_sum_table(N, m, f.f_prime, prime_power);
+            assert(table.first == prime_counting_modulo_table(N, m).first);
+            for (std::size_t i = 0; i < table.first.size(); ++i) {
+                std::uint64_t sum = 0;
+                for (long long n = 1; n <= table.first[i]; ++n) {
+                    sum += values[n];
+                }
+                assert(table.second[i] == sum);
+            }
+        }
+    }
+}
+
+void self_test_large() {
+    const long long N = 2000000;
+    std::uint64_t state = 2;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (const long long m : {1LL, 4LL, 30LL, 97LL}) {
+        const Function f = random_function(m, next);
+        const auto values = f.values(N);
+        std::uint64_t naive = 0;
+        for (long long n = 1; n <= N; ++n) {
+            naive += values[n];
+        }
+        auto prime_power = [&f](long long p, long long e) {
+            return f.prime_power(p, e);
+        };
+        assert(multiplicative_prefix_sum(N, m, f.f_prime, prime_power) ==
+               naive);
+        assert(multiplicative_prefix_sum(N, m, f.f_prime, prime_power, 2) ==
+               naive);
+    }
+}
+
+void self_test_characters() {
+    // Σ_{d|n} χ(d)（χ は法 4 の非自明な指標）の和は、x^2 + y^2 <= N の格子点の個数から求まる。
+    const long long N = 1000000;
+    const std::vector<long long> f_prime = {0, 2, 1, 0};
+    auto prime_power = [](long long p, long long e) -> long long {
+        if (p == 2) {
+            return 1;
+        }
+        return p % 4 == 1 ? e + 1 : (e % 2 == 0 ? 1 : 0);
+    };
+    long long points = 0;
+    for (long long x = 1; x * x <= N; ++x) {
+        for (long long y = 0; x * x + y * y <= N; ++y) {
+            ++points;
+        }
+    }
+    assert(multiplicative_prefix_sum(N, 4, f_prime, prime_power) == points);
+}
+} // namespace
+
+int main() {
+    self_test_small();
+    self_test_large();
+    self_test_characters();
+
+    return 0;
+}
@@ -1,8 +1,12 @@
 // competitive-verifier: STANDALONE
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
+#include "../math/modint/montgomery-modint-128.hpp"
 #include "../math/multiplicative-function/prime-counting-modulo.hpp"
 
 namespace {
@@ -47,7 +51,21 @@ void self_test() {
                 }
             }
 
+            const auto flat = prime_counting_modulo_flat_table(N, m);
+            assert(flat.first == ns);
+            assert(flat.second.size() == ns.size() * m);
+            for (long long r = 0; r < m; ++r) {
+                for (long long i = 0; i < static_cast<long long>(ns.size());
+                     ++i) {
+                    assert(flat.second[i * m + r] == h[r][i]);
+                }
+            }
+
             const auto res = prime_counting_modulo(N, m);
+            const auto lucy = prime_counting_modulo(
+                N, m, 1, PrimeCountingModuloEngine::Lucy);
+            const auto fenwick = prime_counting_modulo(
+                N, m, 2, PrimeCountingModuloEngine::Fenwick);
             for (long long r = 0; r < m; ++r) {
                 long long naive = 0;
                 for (long long p = 2; p <= N; ++p) {
@@ -56,6 +74,8 @@ void self_test() {
                     }
                 }
                 assert(res[r] == naive);
+                assert(lucy[r] == naive);
+                assert(fenwick[r] == naive);
             }
 
             const auto mf =
@@ -86,10 +106,136 @@ void self_test() {
         }
     }
 }
+
+void self_test_large_moduli() {
+    // m と互いに素でない余りは m の素因数のみからなる。
+    const int N = 1000000;
+    const auto is_prime = prime_table(N);
+    for (const long long m : {210LL, 2310LL, 1024LL, 9973LL, 19946LL}) {
+        std::vector<long long> naive(m);
+        for (int p = 2; p <= N; ++p) {
+            if (is_prime[p]) {
+                ++naive[p % m];
+            }
+        }
+        assert(prime_counting_modulo(N, m) == naive);
+        assert(prime_counting_modulo(N, m, 1,
+                                     PrimeCountingModuloEngine::Lucy) == naive);
+        if (m > 2310) {
+            continue;
+        }
+        const auto flat = prime_counting_modulo_flat_table(N, m);
+        for (long long r = 0; r < m; ++r) {
+            assert(flat.second[m + r] == naive[r]);
+        }
+    }
+}
+
+void self_test_engines() {
+    // 2 つの方法の結果は一致する。
+    for (const long long N : {999999999LL, 1000000000LL, 3000000007LL}) {
+        for (const long long m : {1LL, 2LL, 3LL, 4LL, 30LL, 97LL}) {
+            assert(prime_counting_modulo(N, m, 1,
+                                         PrimeCountingModuloEngine::Lucy) ==
+                   prime_counting_modulo(N, m, 1,
+                                         PrimeCountingModuloEngine::Fenwick));
+        }
+    }
+    assert(prime_counting_modulo(1000000000, 1)[0] == 50847534);
+}
+
+void self_test_parallel() {
+    // 複数のスレッドで分担しても結果は一致する。
+    for (const auto &[N, m] : {std::pair<long long, long long>{100000000, 30},
+                               {30000000, 7},
+                               {10000000, 1},
+                               {1000, 5}}) {
+        const auto expected = prime_counting_modulo_flat_table(N, m);
+        for (const unsigned thread_count : {0U, 2U, 3U, 4U}) {
+            assert(prime_counting_modulo_flat_table(N, m, thread_count) ==
+                   expected);
+        }
+        const auto table = prime_counting_modulo_table(N, m, 3);
+        for (long long r = 0; r < m; ++r) {
+            assert(prime_counting_modulo(N, m, 2)[r] == expected.second[m + r]);
+            for (std::size_t i = 0; i < table.first.size(); ++i) {
+                assert(table.second[r][i] == expected.second[i * m + r]);
+            }
+        }
+    }
+    assert(prime_counting_modulo(100000000, 1, 4)[0] == 5761455);
+}
+
+void self_test_power_sums() {
+    // 2^64 を法として全ての値を調べる。
+    using u64 = std::uint64_t;
+    for (long long N = 0; N <= 200; ++N) {
+        const auto is_prime = prime_table(static_cast<int>(N));
+        for (long long m = 1; m <= 10; ++m) {
+            const auto table = prime_power_sum_modulo_table<u64>(N, m, 3);
+            const auto &ns = table.first;
+            assert(ns == prime_counting_modulo_table(N, m).first);
+            assert(table.second.size() == 4);
+            for (long long d = 0; d <= 3; ++d) {
+                assert(static_cast<long long>(table.second[d].size()) == m);
+                for (long long r = 0; r < m; ++r) {
+                    assert(table.second[d][r].size() == ns.size());
+                    for (std::size_t i = 0; i < ns.size(); ++i) {
+                        u64 naive = 0;
+                        for (long long p = 2; p <= ns[i]; ++p) {
+                            if (is_prime[p] && p % m == r) {
+                                u64 power = 1;
+                                for (long long e = 0; e < d; ++e) {
+                                    power *= static_cast<u64>(p);
+                                }
+                                naive += power;
+                            }
+                        }
+                        assert(table.second[d][r][i] == naive);
+                    }
+                }
+            }
+        }
+    }
+
+    // 素数を法として、N 以下の素数の 2 乗までの和を調べる。
+    using mint = StaticMontgomeryModInt128<0, 998244353>;
+    const int N = 1000000;
+    const auto is_prime = prime_table(N);
+    for (const long long m : {1LL, 4LL, 30LL, 97LL}) {
+        std::vector<std::vector<mint>> naive(3, std::vector<mint>(m));
+        for (int p = 2; p <= N; ++p) {
+            if (is_prime[p]) {
+                const mint x(p);
+                naive[0][p % m] += mint(1);
+                naive[1][p % m] += x;
+                naive[2][p % m] += x * x;
+            }
+        }
+        const auto table = prime_power_sum_modulo_table<mint>(N, m, 2);
+        const auto parallel = prime_power_sum_modulo_table<mint>(N, m, 2, 3);
+        const auto counts = prime_counting_modulo_table(N, m).second;
+        for (long long d = 0; d <= 2; ++d) {
+            for (long long r = 0; r < m; ++r) {
+                assert(table.second[d][r][1] == naive[d][r]);
+                assert(parallel.second[d][r] == table.second[d][r]);
+                if (d == 0) {
+                    for (std::size_t i = 0; i < counts[r].size(); ++i) {
+                        assert(table.second[0][r][i] == mint(counts[r][i]));
+                    }
+                }
+            }
+        }
+    }
+}
 } // namespace
 
 int main() {
     self_test();
+    self_test_large_moduli();
+    self_test_engines();
+    self_test_parallel();
+    self_test_power_sums();
 
     return 0;
 }
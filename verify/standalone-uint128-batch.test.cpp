@@ -0,0 +1,99 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../internal/int128.hpp"
+#include "../internal/uint128-batch.hpp"
+
+namespace {
+using NicheLibrary::UInt128;
+using NicheLibrary::UInt128Array;
+
+template <class Next>
+std::vector<UInt128> random_values(std::size_t size, Next &next) {
+    std::vector<UInt128> values(size);
+    for (UInt128 &value : values) {
+        std::uint64_t high = next();
+        std::uint64_t low = next();
+        // 繰り上がりと上位の語の比較が起きやすい値を混ぜる。
+        if (next() % 4 == 0) {
+            low = ~std::uint64_t{} - next() % 3;
+        }
+        if (next() % 4 == 0) {
+            high = next() % 3;
+        }
+        value = UInt128::from_words(high, low);
+    }
+    return values;
+}
+} // namespace
+
+int main() {
+    std::uint64_t state = 42;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (const std::size_t size : {0, 1, 2, 3, 7, 8, 31, 1000}) {
+        const std::vector<UInt128> a = random_values(size, next);
+        const std::vector<UInt128> b = random_values(size, next);
+        const UInt128Array lhs(a);
+        const UInt128Array rhs(b);
+        UInt128Array out(size);
+
+        NicheLibrary::uint128_batch_add(lhs.span(), rhs.span(), out.span());
+        for (std::size_t i = 0; i < size; ++i) {
+            assert(out[i] == a[i] + b[i]);
+        }
+
+        NicheLibrary::uint128_batch_sub(lhs.span(), rhs.span(), out.span());
+        for (std::size_t i = 0; i < size; ++i) {
+            assert(out[i] == a[i] - b[i]);
+        }
+
+        NicheLibrary::uint128_batch_mul_low(lhs.span(), rhs.span(),
+                                            out.span());
+        for (std::size_t i = 0; i < size; ++i) {
+            assert(out[i] == a[i] * b[i]);
+        }
+
+        const std::unique_ptr<bool[]> less(new bool[size + 1]);
+        NicheLibrary::uint128_batch_less(lhs.span(), rhs.span(), less.get());
+        for (std::size_t i = 0; i < size; ++i) {
+            assert(less[i] == (a[i] < b[i]));
+        }
+
+        // 出力が入力と同じ領域でもよい。
+        UInt128Array in_place(a);
+        NicheLibrary::uint128_batch_add(in_place.span(), rhs.span(),
+                                        in_place.span());
+        NicheLibrary::uint128_batch_mul_low(in_place.span(), in_place.span(),
+                                            in_place.span());
+        for (std::size_t i = 0; i < size; ++i) {
+            assert(in_place[i] == (a[i] + b[i]) * (a[i] + b[i]));
+        }
+
+        UInt128 sum = 0;
+        for (const UInt128 value : a) {
+            sum += value;
+        }
+        assert(NicheLibrary::uint128_batch_sum(lhs.span()) == sum);
+
+        UInt128Array prefix(a);
+        NicheLibrary::uint128_batch_prefix_sum(prefix.span());
+        UInt128 running = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            running += a[i];
+            assert(prefix[i] == running);
+        }
+        assert(prefix.to_vector().size() == size);
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+// competitive-verifier: STANDALONE
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../internal/fixed-width-int.hpp"
+#include "../internal/int128.hpp"
+#include "../internal/uint128-divider.hpp"
+
+namespace {
+using NicheLibrary::UInt128;
+using NicheLibrary::UInt128Divider;
+
+void check(const UInt128Divider &divider, UInt128 lhs) {
+    UInt128 expected_quotient;
+    UInt128 expected_remainder;
+    UInt128::div_mod(lhs, divider.divisor(), expected_quotient,
+                     expected_remainder);
+
+    UInt128 quotient;
+    UInt128 remainder;
+    divider.div_mod(lhs, quotient, remainder);
+    assert(quotient == expected_quotient);
+    assert(remainder == expected_remainder);
+    assert(divider.quotient(lhs) == expected_quotient);
+    assert(divider.remainder(lhs) == expected_remainder);
+}
+
+// 256 bit の値の剰余と剰余乗算を、UInt256 の除算と比べる。
+void check_wide(const UInt128Divider &divider, UInt128 lhs, UInt128 rhs) {
+    using NicheLibrary::UInt256;
+    const UInt128 divisor = divider.divisor();
+    const UInt128 a = lhs % divisor;
+    const UInt256 product = UInt256(a) * UInt256(rhs);
+    const UInt256 expected = product % UInt256(divisor);
+    const UInt128 result = divider.multiply_mod(a, rhs);
+    assert(UInt256(result) == expected);
+    assert(divider.multiply_mod(rhs, a) == result);
+
+    const UInt128 high =
+        UInt128::from_words(product.word(3), product.word(2));
+    const UInt128 low = UInt128::from_words(product.word(1), product.word(0));
+    assert(divider.remainder_wide(high, low) == result);
+}
+
+constexpr bool test_constexpr() {
+    const UInt128Divider small(UInt128(1000000007));
+    const UInt128Divider large(UInt128::from_words(3, 5));
+    const UInt128 value =
+        UInt128::from_words(0x123456789abcdef0ULL, 0xfedcba9876543210ULL);
+    return small.quotient(value) == value / UInt128(1000000007) &&
+           small.remainder(value) == value % UInt128(1000000007) &&
+           large.quotient(value) == value / UInt128::from_words(3, 5) &&
+           large.remainder(value) == value % UInt128::from_words(3, 5) &&
+           large.multiply_mod(UInt128(7), value) ==
+               UInt128(7) * value % UInt128::from_words(3, 5);
+}
+} // namespace
+
+int main() {
+    static_assert(test_constexpr(), "UInt128Divider must be constexpr.");
+
+    std::vector<UInt128> values = {
+        UInt128(0),
+        UInt128(1),
+        UInt128(2),
+        UInt128(3),
+        UInt128(1000000007),
+        UInt128::from_words(0, (std::uint64_t{1} << 32) - 1),
+        UInt128::from_words(0, std::uint64_t{1} << 32),
+        UInt128::from_words(0, (std::uint64_t{1} << 63) - 1),
+        UInt128::from_words(0, std::uint64_t{1} << 63),
+        UInt128::from_words(0, (std::uint64_t{1} << 63) + 1),
+        UInt128::from_words(0, ~std::uint64_t{}),
+        UInt128::from_words(1, 0),
+        UInt128::from_words(1, 1),
+        UInt128::from_words(1, ~std::uint64_t{}),
+        UInt128::from_words((std::uint64_t{1} << 32) - 1, ~std::uint64_t{}),
+        UInt128::from_words(std::uint64_t{1} << 63, 0),
+        UInt128::from_words((std::uint64_t{1} << 63) - 1, ~std::uint64_t{}),
+        UInt128::from_words(0x123456789abcdef0ULL, 0xfedcba9876543210ULL),
+        UInt128::from_words(~std::uint64_t{}, ~std::uint64_t{} - 1),
+        UInt128::from_words(~std::uint64_t{}, ~std::uint64_t{}),
+    };
+    std::uint64_t state = 12345;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    for (int i = 0; i < 40; ++i) {
+        const int shift = i % 64;
+        const std::uint64_t high = next() >> shift;
+        values.push_back(UInt128::from_words(i < 20 ? 0 : high,
+                                             next() >> (i % 7)));
+    }
+
+    for (const UInt128 divisor : values) {
+        if (divisor == UInt128{}) {
+            continue;
+        }
+        const UInt128Divider divider(divisor);
+        assert(divider.divisor() == divisor);
+        for (const UInt128 lhs : values) {
+            check(divider, lhs);
+            check(divider, lhs * divisor);
+            check(divider, lhs * divisor + divisor - UInt128(1));
+        }
+        for (int i = 0; i < 200; ++i) {
+            const UInt128 lhs =
+                UInt128::from_words(next(), next());
+            check(divider, lhs);
+        }
+        const UInt128 max_value =
+            UInt128::from_words(~std::uint64_t{}, ~std::uint64_t{});
+        for (const UInt128 lhs : values) {
+            check_wide(divider, lhs, lhs);
+            check_wide(divider, divisor - UInt128(1), lhs);
+            check_wide(divider, lhs, max_value);
+        }
+        for (int i = 0; i < 50; ++i) {
+            const UInt128 lhs =
+                UInt128::from_words(next(), next());
+            const UInt128 rhs =
+                UInt128::from_words(next(), next());
+            check_wide(divider, lhs, rhs);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+// competitive-verifier: STANDALONE
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+#include "../internal/fixed-width-int.hpp"
+#include "../internal/int128.hpp"
+#include "../math/number-theory/universal-euclidean.hpp"
+
+namespace {
+// 格子路そのものを文字列として表すモノイド。
+struct Path {
+    std::string value;
+
+    friend Path operator*(const Path &lhs, const Path &rhs) {
+        return {lhs.value + rhs.value};
+    }
+};
+
+std::string brute_path(long long n, long long p, long long q, long long r) {
+    std::string path;
+    long long previous = 0;
+    for (long long i = 0; i < n; ++i) {
+        const long long current = (p * i + r) / q;
+        path += std::string(static_cast<std::size_t>(current - previous), 'U');
+        path += 'R';
+        previous = current;
+    }
+    return path;
+}
+
+// 998244353 を法とする 2 次正方行列。非可換なモノイドの例として用いる。
+struct Matrix {
+    static constexpr std::uint64_t mod = 998244353;
+    std::array<std::array<std::uint64_t, 2>, 2> value = {{{1, 0}, {0, 1}}};
+
+    friend Matrix operator*(const Matrix &lhs, const Matrix &rhs) {
+        Matrix res;
+        for (int i = 0; i < 2; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                res.value[i][j] = (lhs.value[i][0] * rhs.value[0][j] +
+                                   lhs.value[i][1] * rhs.value[1][j]) %
+                                  mod;
+            }
+        }
+        return res;
+    }
+
+    friend bool operator==(const Matrix &lhs, const Matrix &rhs) {
+        return lhs.value == rhs.value;
+    }
+};
+
+// right の個数、up の個数、各 right の位置での up の個数の和を持つモノイド。
+template <class Value> struct FloorSum {
+    Value count_x = 0;
+    Value count_y = 0;
+    Value sum_y = 0;
+
+    friend FloorSum operator*(const FloorSum &lhs, const FloorSum &rhs) {
+        return {lhs.count_x + rhs.count_x, lhs.count_y + rhs.count_y,
+                lhs.sum_y + rhs.sum_y + lhs.count_y * rhs.count_x};
+    }
+};
+} // namespace
+
+int main() {
+    for (long long n = 0; n <= 12; ++n) {
+        for (long long q = 1; q <= 12; ++q) {
+            for (long long p = 0; p <= 30; ++p) {
+                for (long long r = 0; r <= 30; ++r) {
+                    const Path path = universal_euclidean(n, p, q, r, Path{"U"},
+                                                          Path{"R"});
+                    assert(path.value == brute_path(n, p, q, r));
+                }
+            }
+        }
+    }
+
+    {
+        std::uint64_t state = 1;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        Matrix up;
+        up.value = {{{1, 1}, {0, 1}}};
+        Matrix right;
+        right.value = {{{2, 0}, {1, 3}}};
+        for (int i = 0; i < 2000; ++i) {
+            const long long n = static_cast<long long>(next() % 300);
+            const long long q = static_cast<long long>(next() % 300) + 1;
+            const long long p = static_cast<long long>(next() % 1000);
+            const long long r = static_cast<long long>(next() % 1000);
+            Matrix expected;
+            long long previous = 0;
+            for (long long x = 0; x < n; ++x) {
+                const long long current = (p * x + r) / q;
+                for (long long k = previous; k < current; ++k) {
+                    expected = expected * up;
+                }
+                expected = expected * right;
+                previous = current;
+            }
+            assert(universal_euclidean(n, p, q, r, up, right) == expected);
+        }
+    }
+
+    {
+        // p (n - 1) + r が 64 bit に収まらない場合は、Wide を広い型にして計算する。
+        using NicheLibrary::Int128;
+        using NicheLibrary::Int256;
+        std::uint64_t state = 3;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        const FloorSum<Int256> up = {0, 1, 0};
+        const FloorSum<Int256> right = {1, 0, 0};
+        for (int i = 0; i < 10000; ++i) {
+            const int bits = static_cast<int>(next() % 62) + 1;
+            const long long n =
+                static_cast<long long>(next() % (1ULL << bits));
+            const long long q =
+                static_cast<long long>(next() % (1ULL << 62)) + 1;
+            const long long p =
+                static_cast<long long>(next() % (1ULL << (62 - bits / 2)));
+            const long long r = static_cast<long long>(next() % (1ULL << 62));
+            const auto res = universal_euclidean(n, p, q, r, up, right);
+            const auto res_int128 = universal_euclidean(
+                Int128(n), Int128(p), Int128(q), Int128(r), up, right);
+            const auto res_int256 =
+                universal_euclidean<Int256>(n, p, q, r, up, right);
+            assert(res.count_x == Int256(n));
+            assert(res.sum_y == res_int128.sum_y);
+            assert(res.sum_y == res_int256.sum_y);
+            assert(res.count_y == res_int128.count_y);
+
+            // 最後の項 floor((p (n - 1) + r) / q) は up の個数に等しい。
+            if (n > 0) {
+                const Int256 last =
+                    (Int256(p) * Int256(n - 1) + Int256(r)) / Int256(q);
+                assert(res.count_y == last);
+            }
+        }
+    }
+
+    {
+        // Wide を T にすると、T のまま計算する。
+        const FloorSum<long long> up = {0, 1, 0};
+        const FloorSum<long long> right = {1, 0, 0};
+        for (long long n = 0; n <= 40; ++n) {
+            for (long long q = 1; q <= 40; ++q) {
+                for (long long p = 0; p <= 40; ++p) {
+                    const long long r = (n * 7 + q * 3 + p) % 50;
+                    long long expected = 0;
+                    for (long long x = 0; x < n; ++x) {
+                        expected += (p * x + r) / q;
+                    }
+                    assert(universal_euclidean<long long>(n, p, q, r, up,
+                                                          right)
+                               .sum_y == expected);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -1,6 +1,13 @@
 // competitive-verifier: PROBLEM https://judge.yosupo.jp/problem/many_aplusb_128bit
 
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
 #include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
 
 #include "../internal/int128.hpp"
 
@@ -8,13 +15,28 @@ int main() {
     std::ios::sync_with_stdio(false);
     std::cin.tie(nullptr);
 
-    int t;
-    std::cin >> t;
-    while (t--) {
-        NicheLibrary::Int128 a, b;
-        std::cin >> a >> b;
-        std::cout << a + b << '\n';
+    std::string input;
+    char chunk[1 << 16];
+    std::size_t size;
+    while ((size = std::fread(chunk, 1, sizeof(chunk), stdin)) != 0) {
+        input.append(chunk, size);
     }
 
+    std::vector<NicheLibrary::Int128> values;
+    const std::from_chars_result result = NicheLibrary::parse_int128_sequence(
+        input.data(), input.data() + input.size(), values);
+    assert(result.ec == std::errc{});
+
+    const std::size_t t = static_cast<std::size_t>(values[0]);
+    std::string output(t * 41, '\0');
+    char *first = output.data();
+    char *const last = first + output.size();
+    for (std::size_t i = 0; i < t; ++i) {
+        const NicheLibrary::Int128 sum = values[2 * i + 1] + values[2 * i + 2];
+        first = NicheLibrary::to_chars(first, last, sum).ptr;
+        *first++ = '\n';
+    }
+    std::fwrite(output.data(), 1, first - output.data(), stdout);
+
     return 0;
 }